@@ -34,53 +34,19 @@ void Account::updateAccount() noexcept
 {
     K->fetchAccountBalance(*this);
     K->fetchAllTickers();
+    const AssetPairs &pairs(K->getPairs());
 
     for (size_t ii(0); ii < assets.size(); ii++)
     {
-        for (size_t jj(0); jj<CF.tickerList.size(); jj++)
+        AssetPairs::AssetInfo info(pairs.resolve(assets[ii]));
+        if (info.pair != AssetPairs::npos)
         {
-            std::string ticker(CF.tickerList[jj]);
-            double minimum(CF.tickerMinimum[jj]);
-            std::string assetName(assets[ii]);
-
-            size_t tickerPosition(ticker.find(assetName));
-            if (tickerPosition == 0 || tickerPosition == 1)
-            {
-                tickers[ii] = ticker;
-                minimums[ii] = minimum;
-                break;
-            }
-
-            assetName.erase(0, 1);
-            tickerPosition = ticker.find(assetName);
-            if (tickerPosition == 0)
-            {
-                tickers[ii] = ticker;
-                minimums[ii] = minimum;
-                break;
-            }
+            tickers[ii] = pairs.tickers[info.pair];
+            minimums[ii] = info.minimum;
         }
+        active[ii] = info.tradeable;
 
         K->extractTickerPrice(prices[ii], tickers[ii]);
-
-        for (const auto &tradeAsset : CF.tradeableAssets)
-        {
-            std::string assetName(assets[ii]);
-            size_t tickerPosition(tradeAsset.find(assetName));
-            if (tickerPosition == 0 || tickerPosition == 1)
-            {
-                active[ii] = true;
-                break;
-            }
-
-            assetName.erase(0, 1);
-            tickerPosition = tradeAsset.find(assetName);
-            if (tickerPosition == 0)
-            {
-                active[ii] = true;
-                break;
-            }
-        }
     }
 
     std::cout << "Accout updateAccount() executed." << std::endl;
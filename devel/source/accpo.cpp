@@ -18,11 +18,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "accpo.h"
 
-void accpo() noexcept
+void accpo(Scheduler &scheduler) noexcept
 {
-    std::shared_ptr<Kraken> K = std::make_shared<Kraken>(CF.apiKey, CF.secKey);
+    std::shared_ptr<Kraken> K = std::make_shared<Kraken>(CF.apiKey, CF.secKey, scheduler);
 
     K->checkTimeStatus();
+    K->fetchAssetPairs();
 
     std::unique_ptr<Account> A = std::make_unique<Account>(K);
     std::cout << A->printAccount().str();
@@ -71,7 +72,14 @@ void accpo() noexcept
     newTrade.limit = 1.5;
     K->addTradePipeline(newTrade);*/
 
+    if (scheduler.stopping())
+    {
+        std::cout << "Shutdown requested before trading - no orders are placed." << std::endl;
+        return;
+    }
+
     K->processTradePipeline();
+    K->reconcileTradePipeline();
 
     A->updateAccount();
     std::cout << A->printAccount().str();
@@ -89,13 +97,25 @@ auto main() -> int
     std::cout << "======== Version: 0.2 =============================================================================================" << std::endl;
     std::cout << "===================================================================================================================" << std::endl;
 
-    std::thread accpoThread = std::thread(accpo);
+    Scheduler scheduler;
+
+    std::thread accpoThread = std::thread([&scheduler]() {
+        accpo(scheduler);
+        scheduler.requestShutdown("ACCPO finished.");
+    });
+
+    std::thread keyThread = std::thread([&scheduler]() {
+        if (std::cin.get() != std::char_traits<char>::eof())
+        {
+            scheduler.requestShutdown("Keystroke detected.");
+        }
+    });
+    keyThread.detach();
 
-    std::system("read -n 1");
-    CF.terminateProgram.store(true);
+    scheduler.waitShutdown();
 
     std::cout << "===================================================================================================================" << std::endl;
-    std::cout << "Keystroke detected." << std::endl;
+    std::cout << scheduler.getReason() << std::endl;
     std::cout << "Preparing to terminate execution and stopping program." << std::endl;
 
     accpoThread.join();
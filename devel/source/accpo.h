@@ -26,9 +26,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "portfolio.h"
 #include "optimizer.h"
 #include "predict.h"
+#include "scheduler.h"
 #include "utils.h"
 
-void accpo() noexcept;
+void accpo(Scheduler &scheduler) noexcept;
 auto main() -> int;
 
 #endif
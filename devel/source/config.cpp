@@ -23,6 +23,20 @@ Configuration::Configuration() noexcept
     readParameter(apiKey, "API_KEY");
     readParameter(secKey, "SEC_KEY");
 
+    std::string tradeable;
+    readParameter(tradeable, "TRADEABLE_ASSETS");
+    if (!tradeable.empty())
+    {
+        std::stringstream streamTradeable(tradeable);
+        tradeableAssets.clear();
+        while (streamTradeable.good())
+        {
+            std::string substring;
+            std::getline(streamTradeable, substring, ',');
+            tradeableAssets.emplace_back(substring);
+        }
+    }
+
     std::stringstream streamStarttime(inputTime);
     std::vector<int> utc;
     while (streamStarttime.good())
@@ -30,31 +30,41 @@ public:
     // From the key file we are only reading the Kraken API keys
     // All other variables are at the moment defined here in the code
 
-    // Need to include riskfree asset as first element in list
-    const std::vector<std::string> tickerList{"ZEURZEUR","XREPZEUR",
-                                              "ADAEUR","ALGOEUR","ATOMEUR","BALEUR","COMPEUR","CRVEUR","DAIEUR","DASHEUR",
-                                              "DOTEUR","EOSEUR","GNOEUR","KAVAEUR","KSMEUR","LINKEUR","NANOEUR","OMGEUR","OXTEUR",
-                                              "PAXGEUR","QTUMEUR","SCEUR","SNXEUR","STORJEUR","TRXEUR","WAVESEUR","XDGEUR",
-                                              "XETHZEUR","XLTCZEUR","XMLNZEUR","XTZEUR","XXLMZEUR","XXMRZEUR","XXRPZEUR","XZECZEUR"};
-    const std::vector<double> tickerMinimum{0.0, 0.3,
-                                            50.0, 50.0, 1.0, 0.1, 0.025, 1.0, 10.0, 0.03,
-                                            1.0, 3.0, 0.02, 10.0, 0.1, 2.0, 10.0, 5.0, 50.0,
-                                            0.005, 5.0, 2000.0, 1.0, 50.0, 500.0, 10.0, 3000.0,
-                                            0.02, 0.1, 0.1, 1.0, 30.0, 0.1, 30.0, 0.03};
+    // Pairs and their minimum order sizes are read from the AssetPairs service (see pairs.h)
+    // Cached in pairsFile and fetched again from Kraken after pairsTtl seconds
+    const std::string riskfreeAsset{"ZEUR"};
+    const std::string riskfreeTicker{"ZEURZEUR"};
+    // The riskfree asset has no OHLC data of its own - its timebins are taken from this pair with a long history on Kraken
+    const std::string referenceTicker{"XXBTZEUR"};
+    const std::string pairsFile{"assetpairs.json"};
+    const long pairsTtl{86400};
     const std::string inputTime{"2020,09,30,00,00,00"};
     const std::string interVal{"1440"};
     const double tradeFee{0.0026};
     const double weightDiff{0.001};
     const long pauseApi{3};
     const long pauseProgram{30};
-    const size_t lengthTxID{19};
+    // Orders are placed on orderConnections parallel connections
+    // Kraken rejects nonces arriving out of order - private calls of all connections are serialised unless the API key has a nonceWindow
+    // Rate budget of orders: burst of orderBurst orders, then one further order every orderRefill seconds
+    const size_t orderConnections{1};
+    const bool nonceWindow{false};
+    const double orderBurst{15.0};
+    const double orderRefill{1.0};
+    // Status of placed orders is polled after orderPollStart seconds, then with doubling delay up to orderPollMax seconds
+    // Placed orders are awaited for up to orderSettle seconds before the account is updated
+    const double orderPollStart{1.0};
+    const double orderPollMax{30.0};
+    // Kraken accepts at most orderQueryBatch txids per order status query
+    const size_t orderQueryBatch{50};
+    const long orderSettle{120};
     const bool execute{false};
     std::string apiKey, secKey;
     std::string startTime;
 
     // Need to include riskfree asset as first element in list
-    // Which assets do we want to trade? Define here
-    const std::vector<std::string> tradeableAssets{"ZEUR", "XZEC", "XREP", "XXLM", "XXMR", "DASH"};
+    // Which assets do we want to trade? Define here or as TRADEABLE_ASSETS in the key file
+    std::vector<std::string> tradeableAssets{"ZEUR", "XZEC", "XREP", "XXLM", "XXMR", "DASH"};
 
     // Following variables are internal
     std::map<size_t, std::string> idx2str = {std::make_pair(0, "INITIAL"),
@@ -63,8 +73,6 @@ public:
     static constexpr size_t INI{0};
     static constexpr size_t BAL{1};
 
-    std::atomic<bool> terminateProgram{false};
-
     void readParameter(std::string &data, const std::string &parameter) noexcept;
 
     Configuration() noexcept;
@@ -18,31 +18,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "kraken.h"
 
-void Kraken::fetchAllTXID() noexcept
-{
-    std::string txIDList;
-    for (auto &tradeObject : tradePipeline)
-    {
-        if (tradeObject.txid.size() == CF.lengthTxID)
-        {
-            txIDList += tradeObject.txid + ",";
-        }
-        else
-        {
-            std::cout << "Kraken INVALID TXID detected for " << tradeObject.ticker << " with TXID " << tradeObject.txid << std::endl;
-        }
-        
-    }
-    txIDList.pop_back();
-
-    krakenAPI->priv_func->query_order_info(&krakenAPI, txIDList.c_str());
-    txidBuffer = json::parse(krakenAPI->s_result);
-
-    std::cout << "Kraken txIDBuffer contains now: " << txidBuffer.dump() << std::endl;
-    std::cout << "Kraken fetchAllTXID() executed for: " << txIDList << std::endl;
-    pauseApi();
-}
-
 void Kraken::processTradePipeline() noexcept
 {
     std::cout << "===================================================================================================================" << std::endl;
@@ -64,31 +39,25 @@ void Kraken::processTradePipeline() noexcept
         std::cout << " and type " << tradeObject.market << std::endl;
     }
 
-    for (auto &tradeObject : tradePipeline)
+    orders.submit(tradePipeline);
+    orders.track(tradePipeline);
+
+    std::cout << "Kraken processTradePipeline() executed." << std::endl;
+}
+
+void Kraken::reconcileTradePipeline() noexcept
+{
+    if (!orders.settle(CF.orderSettle))
     {
-        placeOrder(tradeObject);
+        std::cout << "Kraken orders still outstanding after " << std::to_string(CF.orderSettle) << " seconds." << std::endl;
     }
 
-    fetchAllTXID();
-
-    for (auto &tradeObject : tradePipeline)
+    for (auto const &fill : orders.reconcile(tradePipeline))
     {
-        if (tradeObject.txid.size() == CF.lengthTxID)
-        {
-            std::string orderStatus(txidBuffer["result"][tradeObject.txid]["status"]);
-            std::cout << "Kraken TXID " << tradeObject.txid << " with status " << orderStatus << std::endl;
-            if (orderStatus == "closed")
-            {
-                tradeObject.executed = true;
-            }
-        }
-        else
-        {
-            std::cout << "Kraken INVALID TXID detected for " << tradeObject.ticker << " with TXID " << tradeObject.txid << std::endl;
-        }
-        
+        std::cout << "Kraken fill of " << fill.ticker << " with quantity " << num2str(fill.quantity, 8);
+        std::cout << " at price " << num2str(fill.price, 8) << " for TXID " << fill.txid << std::endl;
     }
-            
+
     for (auto const &tradeObject : tradePipeline)
     {
         std::cout << "Kraken ";
@@ -100,56 +69,11 @@ void Kraken::processTradePipeline() noexcept
         std::cout << " and execution status " << bool2str(tradeObject.executed) << " and PV ";
         std::cout << num2str(tradeObject.price * tradeObject.quantity, 8);
         std::cout << " and limit " << num2str(tradeObject.limit, 8);
-        std::cout << " and type " << tradeObject.market << std::endl;
+        std::cout << " and type " << tradeObject.market << " and state " << state2str(tradeObject.state) << std::endl;
     }
     std::cout << "Kraken trade pipeline size " << std::to_string(tradePipeline.size()) << std::endl;
     std::cout << "===================================================================================================================" << std::endl;
-    std::cout << "Kraken executeTradePipeline() executed." << std::endl;
-}
-
-void Kraken::placeOrder(Trade &tradeObject) noexcept
-{
-    std::string orderType, orderMarket, orderTicker, orderQuantity, orderLimit;
-    if (tradeObject.quantity > 0)
-    {
-        orderType = "buy";
-        orderQuantity = num2str(fabs(tradeObject.quantity - 0.00000001), 8);
-    }
-    else
-    {
-        orderType = "sell";
-        orderQuantity = num2str(fabs(tradeObject.quantity + 0.00000001), 8);
-    }
-    
-    orderMarket = tradeObject.market;
-    orderTicker = tradeObject.ticker;
-    if (orderMarket == "limit")
-    {
-        orderLimit = num2str(tradeObject.limit, 8);
-        krakenAPI->priv_func->add_order(&krakenAPI, orderType.c_str(), orderMarket.c_str(), orderTicker.c_str(), orderQuantity.c_str(), orderLimit.c_str());
-    }
-    else
-    {
-        krakenAPI->priv_func->add_order(&krakenAPI, orderType.c_str(), orderMarket.c_str(), orderTicker.c_str(), orderQuantity.c_str());
-    }
-
-    std::string result(krakenAPI->s_result);
-    json orderStatus = json::parse(result);
-
-    tradeObject.txid = orderStatus["result"]["txid"][0].dump();
-    tradeObject.txid.pop_back();
-    tradeObject.txid.erase(0, 1);
-
-    std::cout << "Kraken TXID -- " << tradeObject.txid << " -- placed of " << orderStatus["result"]["descr"]["order"].dump() << std::endl;
-    
-    if (tradeObject.txid.size() == CF.lengthTxID)
-    {
-        tradeObject.placed = true;
-    }
-
-    std::cout << "Kraken placeOrder() executed for: " << tradeObject.ticker << std::endl;
-    std::cout << result << std::endl;
-    pauseApi();
+    std::cout << "Kraken reconcileTradePipeline() executed." << std::endl;
 }
 
 void Kraken::addTradePipeline(const Trade &tradeObject) noexcept
@@ -165,34 +89,55 @@ void Kraken::addTradePipeline(const Trade &tradeObject) noexcept
     std::cout << " Execution status: " << bool2str(tradeObject.executed) << std::endl;
 }
 
-void Kraken::fetchAccountBalance(Account &data) noexcept
+void Kraken::fetchAssetPairs() noexcept
 {
-    krakenAPI->priv_func->get_account_balance(&krakenAPI);
+    if (pairs.readCache())
+    {
+        return;
+    }
+
+    krakenAPI->pub_func->get_tradable_asset_pairs(&krakenAPI);
     json result = json::parse(krakenAPI->s_result);
-    json account(result["result"]);
+    pairs.decode(result["result"]);
+    pairs.writeCache(result["result"]);
 
-    data.assets.clear();
-    data.quants.clear();
+    std::cout << "Kraken fetchAssetPairs() executed." << std::endl;
+    pauseApi();
+}
+
+void Kraken::fetchAccountBalance(Account &data) noexcept
+{
+    json result;
+    {
+        auto lock = orders.privateCall();
+        krakenAPI->priv_func->get_account_balance(&krakenAPI);
+        result = json::parse(krakenAPI->s_result);
+    }
+    json account(result["result"]);
 
-    for (auto slice : account.items())
+    std::vector<std::string> assets;
+    std::vector<double> quants;
+    assets.reserve(account.size());
+    quants.reserve(account.size());
+    for (const auto &[asset, quantity] : account.items())
     {
-        std::string asset(static_cast<std::string>(slice.key().data()));
-        data.assets.emplace_back(asset);
+        assets.emplace_back(asset);
+        quants.emplace_back(std::strtod(quantity.get_ref<const std::string &>().c_str(), nullptr));
     }
 
-    std::sort(data.assets.begin(), data.assets.end(), std::greater<std::string>());
+    // Sort a permutation instead of the balances and gather both arrays once through it
+    std::vector<size_t> order(assets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&assets](const size_t &first, const size_t &second) { return assets[first] > assets[second]; });
 
-    for (const auto &asset : data.assets)
+    data.assets.clear();
+    data.quants.clear();
+    data.assets.reserve(order.size());
+    data.quants.reserve(order.size());
+    for (const auto &id : order)
     {
-        for (auto &[key, value] : account.items())
-        {
-            if (key == asset)
-            {
-                std::string quantity(static_cast<std::string>(value));
-                data.quants.emplace_back(std::stod(quantity));
-                break;
-            }
-        }
+        data.assets.emplace_back(std::move(assets[id]));
+        data.quants.emplace_back(quants[id]);
     }
 
     data.tickers = std::vector<std::string>(data.assets.size(), "none");
@@ -219,11 +164,11 @@ void Kraken::fetchOHLCData(Historic &data, const std::string &ticker) noexcept
     kraken_set_opt(&krakenAPI, "interval", CF.interVal.c_str());
     kraken_set_opt(&krakenAPI, "since", CF.startTime.c_str());
 
-    if (ticker == CF.tickerList[0])
+    if (ticker == CF.riskfreeTicker)
     {
-        krakenAPI->pub_func->get_ohlc_data(&krakenAPI, CF.tickerList.back().c_str());
+        krakenAPI->pub_func->get_ohlc_data(&krakenAPI, CF.referenceTicker.c_str());
         json result = json::parse(krakenAPI->s_result);
-        json ohlc(result["result"][CF.tickerList.back()]);
+        json ohlc(result["result"][CF.referenceTicker]);
 
         for (auto slice : ohlc)
         {
@@ -261,7 +206,7 @@ void Kraken::fetchOHLCData(Historic &data, const std::string &ticker) noexcept
 
 void Kraken::fetchAllTickers() noexcept
 {
-    krakenAPI->pub_func->get_ticker_info(&krakenAPI, vec2str(CF.tickerList).c_str());
+    krakenAPI->pub_func->get_ticker_info(&krakenAPI, vec2str(pairs.tickers).c_str());
     tickerBuffer = json::parse(krakenAPI->s_result);
     std::cout << "Kraken fetchAllTickers() executed." << std::endl;
     pauseApi();
@@ -269,7 +214,7 @@ void Kraken::fetchAllTickers() noexcept
 
 void Kraken::extractTickerData(Current &data, const std::string &ticker) noexcept
 {
-    if (ticker == CF.tickerList[0])
+    if (ticker == CF.riskfreeTicker)
     {
         data.price = 1.0;
         data.ask = 1.0;
@@ -293,7 +238,7 @@ void Kraken::extractTickerData(Current &data, const std::string &ticker) noexcep
 
 void Kraken::extractTickerPrice(double &data, const std::string &ticker) noexcept
 {
-    if (ticker == CF.tickerList[0])
+    if (ticker == CF.riskfreeTicker)
     {
         data = 1.0;
     }
@@ -310,7 +255,10 @@ void Kraken::pauseApi() const noexcept
     free(krakenAPI->s_result);
     krakenAPI->s_result = nullptr;
     std::cout << "Kraken API is paused for: " << std::to_string(CF.pauseApi) << " seconds." << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(CF.pauseApi));
+    if (!scheduler.waitFor(CF.pauseApi))
+    {
+        std::cout << "Kraken API pause interrupted by shutdown." << std::endl;
+    }
 }
 
 void Kraken::checkTimeStatus() noexcept
@@ -324,7 +272,8 @@ void Kraken::checkTimeStatus() noexcept
     std::cout << "The current time delay is " << fabs(static_cast<double>(servertime - systemtime)) << " seconds." << std::endl;
 }
 
-Kraken::Kraken(const std::string &apiKey, const std::string &secKey) noexcept
+Kraken::Kraken(const std::string &apiKey, const std::string &secKey, Scheduler &scheduler) noexcept
+    : scheduler(scheduler), orders(apiKey, secKey, scheduler)
 {
     kraken_init(&krakenAPI, apiKey.c_str(), secKey.c_str());
     std::cout << "Kraken constructor() executed." << std::endl;
@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "utils.h"
 #include "asset.h"
 #include "account.h"
+#include "scheduler.h"
+#include "pairs.h"
+#include "orders.h"
 
 extern "C"
 {
@@ -39,12 +42,14 @@ struct Current;
 class Kraken
 {
 public:
-    void fetchAllTXID() noexcept;
     void processTradePipeline() noexcept;
+    void reconcileTradePipeline() noexcept;
 
-    void placeOrder(Trade &tradeObject) noexcept;
     void addTradePipeline(const Trade &tradeObject) noexcept;
 
+    void fetchAssetPairs() noexcept;
+    [[nodiscard]] auto getPairs() const noexcept -> const AssetPairs & { return pairs; }
+
     void fetchAccountBalance(Account &data) noexcept;
     void fetchServerTime(long &data) noexcept;
     void fetchOHLCData(Historic &data, const std::string &ticker) noexcept;
@@ -56,7 +61,7 @@ public:
     void pauseApi() const noexcept;
     void checkTimeStatus() noexcept;
 
-    Kraken(const std::string &apiKey, const std::string &secKey) noexcept;
+    Kraken(const std::string &apiKey, const std::string &secKey, Scheduler &scheduler) noexcept;
     ~Kraken() noexcept;
     Kraken(const Kraken &source) = delete;
     Kraken(Kraken &&source) = delete;
@@ -64,9 +69,11 @@ public:
     auto operator=(Kraken &&source) -> Kraken & = delete;
 
 private:
+    Scheduler &scheduler;
     struct kraken_api *krakenAPI = nullptr;
     json tickerBuffer{};
-    json txidBuffer{};
+    AssetPairs pairs{};
+    OrderEngine orders;
 
     std::vector<Trade> tradePipeline{};
 };
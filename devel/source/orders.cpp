@@ -0,0 +1,351 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "orders.h"
+
+void OrderEngine::submit(std::vector<Trade> &trades) noexcept
+{
+    std::sort(trades.begin(), trades.end(), compareTradePipeline);
+    auto firstBuy = std::find_if(trades.begin(), trades.end(), [](const Trade &trade) { return trade.quantity > 0; });
+
+    submitSide(trades.begin(), firstBuy);
+    submitSide(firstBuy, trades.end());
+
+    auto failed = static_cast<size_t>(std::count_if(trades.begin(), trades.end(), [](const Trade &trade) { return !trade.placed; }));
+    if (failed > 0)
+    {
+        std::cout << "OrderEngine " << std::to_string(failed) << " of " << std::to_string(trades.size());
+        std::cout << " orders NOT placed - portfolio is only partially rebalanced." << std::endl;
+    }
+    std::cout << "OrderEngine submit() executed for " << std::to_string(trades.size()) << " orders." << std::endl;
+}
+
+auto OrderEngine::privateCall() noexcept -> std::unique_lock<std::mutex>
+{
+    if (CF.nonceWindow)
+    {
+        return std::unique_lock<std::mutex>(nonceMutex, std::defer_lock);
+    }
+    return std::unique_lock<std::mutex>(nonceMutex);
+}
+
+auto OrderEngine::acquire() noexcept -> bool
+{
+    std::chrono::steady_clock::time_point ready;
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex);
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed(now - refilled);
+        tokens = std::min(CF.orderBurst, tokens + elapsed.count() / CF.orderRefill);
+        refilled = now;
+
+        // Reserve a token even if the budget is exhausted - the debt fixes the order in which waiting workers proceed
+        tokens -= 1.0;
+        std::chrono::duration<double> debt(tokens < 0.0 ? -tokens * CF.orderRefill : 0.0);
+        ready = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(debt);
+    }
+    return scheduler.waitUntil(ready);
+}
+
+void OrderEngine::submitSide(std::vector<Trade>::iterator first, std::vector<Trade>::iterator last) noexcept
+{
+    const auto count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [this, &next, first, count](const size_t connection) {
+        for (size_t index = next++; index < count; index = next++)
+        {
+            if (!acquire())
+            {
+                return;
+            }
+            placeOrder(connections[connection], first[static_cast<long>(index)]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t connection = 1; connection < std::min(count, connections.size()); ++connection)
+    {
+        workers.emplace_back(worker, connection);
+    }
+    worker(0);
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+}
+
+void OrderEngine::placeOrder(struct kraken_api *&api, Trade &tradeObject) noexcept
+{
+    std::string orderType, orderMarket, orderTicker, orderQuantity, orderLimit;
+    if (tradeObject.quantity > 0)
+    {
+        orderType = "buy";
+        orderQuantity = num2str(fabs(tradeObject.quantity - 0.00000001), 8);
+    }
+    else
+    {
+        orderType = "sell";
+        orderQuantity = num2str(fabs(tradeObject.quantity + 0.00000001), 8);
+    }
+
+    orderMarket = tradeObject.market;
+    orderTicker = tradeObject.ticker;
+    std::string result;
+    {
+        auto lock = privateCall();
+        if (orderMarket == "limit")
+        {
+            orderLimit = num2str(tradeObject.limit, 8);
+            api->priv_func->add_order(&api, orderType.c_str(), orderMarket.c_str(), orderTicker.c_str(), orderQuantity.c_str(), orderLimit.c_str());
+        }
+        else
+        {
+            api->priv_func->add_order(&api, orderType.c_str(), orderMarket.c_str(), orderTicker.c_str(), orderQuantity.c_str());
+        }
+        result = api->s_result;
+        free(api->s_result);
+        api->s_result = nullptr;
+    }
+    json orderStatus = json::parse(result);
+
+    if (orderStatus.contains("result") && orderStatus["result"].contains("txid") && !orderStatus["result"]["txid"].empty())
+    {
+        tradeObject.txid = orderStatus["result"]["txid"][0].get<std::string>();
+        tradeObject.state = OrderState::Pending;
+        tradeObject.placed = true;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    if (tradeObject.placed)
+    {
+        std::cout << "Kraken TXID -- " << tradeObject.txid << " -- placed of " << orderStatus["result"]["descr"]["order"].dump() << std::endl;
+    }
+    else
+    {
+        std::cout << "Kraken order REJECTED for " << tradeObject.ticker << " with error " << orderStatus["error"].dump() << std::endl;
+    }
+    std::cout << "OrderEngine placeOrder() executed for: " << tradeObject.ticker << std::endl;
+    std::cout << result << std::endl;
+}
+
+void OrderEngine::track(const std::vector<Trade> &trades) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(trackMutex);
+        for (auto const &tradeObject : trades)
+        {
+            if (tradeObject.placed && !isFinal(tradeObject.state))
+            {
+                tracked[tradeObject.txid] = tradeObject;
+            }
+        }
+        outstanding = static_cast<size_t>(std::count_if(tracked.begin(), tracked.end(), [](const auto &entry) { return !isFinal(entry.second.state); }));
+    }
+    newOrders = true;
+    scheduler.notify();
+}
+
+auto OrderEngine::settle(const long &seconds) noexcept -> bool
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    scheduler.waitUntil(deadline, [this]() { return outstanding == 0; });
+    return outstanding == 0;
+}
+
+auto OrderEngine::reconcile(std::vector<Trade> &trades) noexcept -> std::vector<Fill>
+{
+    std::lock_guard<std::mutex> lock(trackMutex);
+    for (auto &tradeObject : trades)
+    {
+        auto order = tracked.find(tradeObject.txid);
+        if (tradeObject.placed && order != tracked.end())
+        {
+            tradeObject.state = order->second.state;
+            tradeObject.filled = order->second.filled;
+            tradeObject.executed = order->second.executed;
+        }
+    }
+
+    std::vector<Fill> result;
+    result.swap(fills);
+    return result;
+}
+
+void OrderEngine::runTracker() noexcept
+{
+    double delay(CF.orderPollStart);
+    while (!stopTracker)
+    {
+        // Without outstanding orders the tracker sleeps until new ones arrive
+        std::chrono::duration<double> wait(outstanding > 0 ? delay : 86400.0);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait);
+        if (!scheduler.waitUntil(deadline, [this]() { return stopTracker || newOrders; }) || stopTracker)
+        {
+            break;
+        }
+
+        if (newOrders.exchange(false))
+        {
+            delay = CF.orderPollStart;
+            continue;
+        }
+
+        queryOrders();
+        delay = std::min(2.0 * delay, CF.orderPollMax);
+    }
+}
+
+void OrderEngine::queryOrders() noexcept
+{
+    std::vector<std::string> txIDs;
+    {
+        std::lock_guard<std::mutex> lock(trackMutex);
+        for (auto const &order : tracked)
+        {
+            if (!isFinal(order.second.state))
+            {
+                txIDs.emplace_back(order.first);
+            }
+        }
+    }
+
+    for (size_t first = 0; first < txIDs.size(); first += CF.orderQueryBatch)
+    {
+        std::string txIDList;
+        for (size_t index = first; index < std::min(first + CF.orderQueryBatch, txIDs.size()); ++index)
+        {
+            txIDList += txIDs[index] + ",";
+        }
+        txIDList.pop_back();
+
+        std::string result;
+        {
+            auto lock = privateCall();
+            trackerAPI->priv_func->query_order_info(&trackerAPI, txIDList.c_str());
+            result = trackerAPI->s_result;
+            free(trackerAPI->s_result);
+            trackerAPI->s_result = nullptr;
+        }
+        json orderStatus = json::parse(result);
+
+        if (!orderStatus.contains("result"))
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << "OrderEngine queryOrders() failed with error " << orderStatus["error"].dump() << std::endl;
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(trackMutex);
+            for (auto const &info : orderStatus["result"].items())
+            {
+                auto order = tracked.find(info.key());
+                if (order != tracked.end())
+                {
+                    applyStatus(order->second, info.value());
+                }
+            }
+            outstanding = static_cast<size_t>(std::count_if(tracked.begin(), tracked.end(), [](const auto &entry) { return !isFinal(entry.second.state); }));
+        }
+        scheduler.notify();
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << "OrderEngine queryOrders() executed for: " << txIDList << std::endl;
+    }
+}
+
+void OrderEngine::applyStatus(Trade &order, const json &info) noexcept
+{
+    std::string status(info.value("status", std::string()));
+    double volume(0.0), price(0.0);
+    if (info.contains("vol_exec") && info["vol_exec"].is_string())
+    {
+        volume = std::strtod(info["vol_exec"].get_ref<const std::string &>().c_str(), nullptr);
+    }
+    if (info.contains("price") && info["price"].is_string())
+    {
+        price = std::strtod(info["price"].get_ref<const std::string &>().c_str(), nullptr);
+    }
+
+    OrderState state(order.state);
+    if (status == "pending")
+    {
+        state = OrderState::Pending;
+    }
+    else if (status == "open")
+    {
+        state = volume > 0.0 ? OrderState::Partial : OrderState::Open;
+    }
+    else if (status == "closed")
+    {
+        state = OrderState::Closed;
+    }
+    else if (status == "canceled")
+    {
+        state = OrderState::Cancelled;
+    }
+    else if (status == "expired")
+    {
+        state = OrderState::Expired;
+    }
+
+    if (volume > order.filled)
+    {
+        Fill fill{order.ticker, order.txid, std::copysign(volume - order.filled, order.quantity), price > 0.0 ? price : order.price};
+        fills.push_back(fill);
+        order.filled = volume;
+    }
+
+    if (state != order.state)
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << "Kraken TXID " << order.txid << " changed from " << state2str(order.state) << " to " << state2str(state) << std::endl;
+    }
+    order.state = state;
+    order.executed = state == OrderState::Closed;
+}
+
+OrderEngine::OrderEngine(const std::string &apiKey, const std::string &secKey, Scheduler &scheduler) noexcept
+    : scheduler(scheduler), connections(CF.orderConnections, nullptr), tokens(CF.orderBurst), refilled(std::chrono::steady_clock::now())
+{
+    for (auto &api : connections)
+    {
+        kraken_init(&api, apiKey.c_str(), secKey.c_str());
+    }
+    kraken_init(&trackerAPI, apiKey.c_str(), secKey.c_str());
+    tracker = std::thread(&OrderEngine::runTracker, this);
+    std::cout << "OrderEngine constructor() executed." << std::endl;
+}
+
+OrderEngine::~OrderEngine() noexcept
+{
+    stopTracker = true;
+    scheduler.notify();
+    tracker.join();
+    kraken_clean(&trackerAPI);
+    for (auto &api : connections)
+    {
+        kraken_clean(&api);
+    }
+    std::cout << "OrderEngine destructor() executed." << std::endl;
+}
@@ -0,0 +1,84 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ORDERS_H
+#define ORDERS_H
+
+#include "config.h"
+#include "scheduler.h"
+#include "utils.h"
+
+extern "C"
+{
+#include "../thirdparty/kraken/kraken_api.hpp"
+}
+
+#include "../thirdparty/json/json.hpp"
+using json = nlohmann::json;
+
+class OrderEngine
+{
+public:
+    // Place all trades - sells before buys, each side concurrently on all connections within the rate budget
+    void submit(std::vector<Trade> &trades) noexcept;
+    // Hand placed trades to the tracker thread - it polls their status in batches with exponential backoff
+    void track(const std::vector<Trade> &trades) noexcept;
+    // Wait up to "seconds" until all tracked orders are closed, cancelled or expired - returns false if some are still outstanding
+    auto settle(const long &seconds) noexcept -> bool;
+    // Copy the latest state of tracked orders into "trades" and return the fills seen since the last call
+    auto reconcile(std::vector<Trade> &trades) noexcept -> std::vector<Fill>;
+    // Lock held during one private call on the API key - serialises nonces of all connections unless the key has a nonce window
+    auto privateCall() noexcept -> std::unique_lock<std::mutex>;
+
+    OrderEngine(const std::string &apiKey, const std::string &secKey, Scheduler &scheduler) noexcept;
+    ~OrderEngine() noexcept;
+    OrderEngine(const OrderEngine &source) = delete;
+    OrderEngine(OrderEngine &&source) = delete;
+    auto operator=(const OrderEngine &source) -> OrderEngine & = delete;
+    auto operator=(OrderEngine &&source) -> OrderEngine & = delete;
+
+private:
+    Scheduler &scheduler;
+    std::vector<struct kraken_api *> connections{};
+
+    std::mutex budgetMutex;
+    double tokens{0.0};
+    std::chrono::steady_clock::time_point refilled{};
+
+    std::mutex outputMutex;
+    std::mutex nonceMutex;
+
+    struct kraken_api *trackerAPI = nullptr;
+    std::mutex trackMutex;
+    std::map<std::string, Trade> tracked{};
+    std::vector<Fill> fills{};
+    std::atomic<size_t> outstanding{0};
+    std::atomic<bool> newOrders{false};
+    std::atomic<bool> stopTracker{false};
+    std::thread tracker;
+
+    auto acquire() noexcept -> bool;
+    void runTracker() noexcept;
+    void queryOrders() noexcept;
+    void applyStatus(Trade &order, const json &info) noexcept;
+    void submitSide(std::vector<Trade>::iterator first, std::vector<Trade>::iterator last) noexcept;
+    void placeOrder(struct kraken_api *&api, Trade &tradeObject) noexcept;
+};
+
+#endif
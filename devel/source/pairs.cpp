@@ -0,0 +1,147 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pairs.h"
+
+auto AssetPairs::find(const std::string &ticker) const noexcept -> size_t
+{
+    auto entry(index.find(ticker));
+    return entry == index.end() ? npos : entry->second;
+}
+
+auto AssetPairs::resolve(const std::string &asset) const noexcept -> AssetInfo
+{
+    auto entry(assets.find(assetCode(asset)));
+    return entry == assets.end() ? AssetInfo{} : entry->second;
+}
+
+auto AssetPairs::takerFee(const size_t &id, const double &volume) const noexcept -> double
+{
+    double fee(CF.tradeFee);
+    for (const auto &[threshold, percent] : feeTiers[id])
+    {
+        if (volume >= threshold)
+        {
+            fee = percent / 100.0;
+        }
+    }
+
+    return fee;
+}
+
+auto AssetPairs::readCache() noexcept -> bool
+{
+    std::ifstream stream(CF.pairsFile);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+
+    json cache = json::parse(stream, nullptr, false);
+    long now;
+    getSystemTime(now);
+    if (cache.is_discarded() || !cache.contains("time") || !cache.contains("result") || cache["time"].get<long>() + CF.pairsTtl < now)
+    {
+        std::cout << "AssetPairs cache " << CF.pairsFile << " is missing or expired." << std::endl;
+        return false;
+    }
+
+    decode(cache["result"]);
+    std::cout << "AssetPairs readCache() executed with " << std::to_string(size()) << " pairs." << std::endl;
+    return true;
+}
+
+void AssetPairs::writeCache(const json &result) const noexcept
+{
+    long now;
+    getSystemTime(now);
+    json cache{{"time", now}, {"result", result}};
+
+    std::ofstream stream(CF.pairsFile);
+    stream << cache.dump();
+    std::cout << "AssetPairs writeCache() executed for " << CF.pairsFile << std::endl;
+}
+
+void AssetPairs::decode(const json &result) noexcept
+{
+    tickers.clear();
+    bases.clear();
+    minimums.clear();
+    priceDecimals.clear();
+    volumeDecimals.clear();
+    feeTiers.clear();
+    index.clear();
+
+    addPair(CF.riskfreeTicker, CF.riskfreeAsset, 0.0, 8, 8);
+    feeTiers.emplace_back();
+
+    for (const auto &[ticker, pair] : result.items())
+    {
+        // Dark pool pairs duplicate base and quote of the regular pair
+        if (ticker.find(".d") != std::string::npos || pair.value("quote", std::string()) != CF.riskfreeAsset)
+        {
+            continue;
+        }
+
+        addPair(ticker, pair.value("base", std::string()), std::stod(pair.value("ordermin", std::string("0"))), pair.value("pair_decimals", 8), pair.value("lot_decimals", 8));
+
+        std::vector<std::pair<double, double>> tiers;
+        for (const auto &tier : pair.value("fees", json::array()))
+        {
+            tiers.emplace_back(tier[0].get<double>(), tier[1].get<double>());
+        }
+        feeTiers.push_back(tiers);
+    }
+
+    buildAssets();
+    std::cout << "AssetPairs decode() executed with " << std::to_string(size()) << " pairs." << std::endl;
+}
+
+void AssetPairs::addPair(const std::string &ticker, const std::string &base, const double &minimum, const int &priceDecimal, const int &volumeDecimal) noexcept
+{
+    index[ticker] = tickers.size();
+    tickers.emplace_back(ticker);
+    bases.emplace_back(base);
+    minimums.emplace_back(minimum);
+    priceDecimals.emplace_back(priceDecimal);
+    volumeDecimals.emplace_back(volumeDecimal);
+}
+
+auto AssetPairs::assetCode(const std::string &asset) noexcept -> std::string
+{
+    // Kraken prefixes legacy crypto codes with X and fiat codes with Z, e.g. XXBT, XETH, ZEUR
+    if (asset.size() == 4 && (asset.front() == 'X' || asset.front() == 'Z'))
+    {
+        return asset.substr(1);
+    }
+    return asset;
+}
+
+void AssetPairs::buildAssets() noexcept
+{
+    assets.clear();
+    for (size_t id(0); id < size(); id++)
+    {
+        assets.emplace(assetCode(bases[id]), AssetInfo{id, minimums[id], false});
+    }
+
+    for (const auto &tradeAsset : CF.tradeableAssets)
+    {
+        assets[assetCode(tradeAsset)].tradeable = true;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PAIRS_H
+#define PAIRS_H
+
+#include "config.h"
+#include "utils.h"
+
+#include "../thirdparty/json/json.hpp"
+using json = nlohmann::json;
+
+class AssetPairs
+{
+public:
+    static constexpr size_t npos{std::numeric_limits<size_t>::max()};
+
+    struct AssetInfo
+    {
+        size_t pair{npos};
+        double minimum{0.0};
+        bool tradeable{false};
+    };
+
+    // Symbol table - one entry per pair quoted in the riskfree asset, riskfree pseudo pair first
+    std::vector<std::string> tickers{};
+    std::vector<std::string> bases{};
+    std::vector<double> minimums{};
+    std::vector<int> priceDecimals{};
+    std::vector<int> volumeDecimals{};
+    std::vector<std::vector<std::pair<double, double>>> feeTiers{};
+
+    [[nodiscard]] auto find(const std::string &ticker) const noexcept -> size_t;
+    [[nodiscard]] auto size() const noexcept -> size_t { return tickers.size(); }
+    [[nodiscard]] auto resolve(const std::string &asset) const noexcept -> AssetInfo;
+    [[nodiscard]] auto takerFee(const size_t &id, const double &volume) const noexcept -> double;
+
+    auto readCache() noexcept -> bool;
+    void writeCache(const json &result) const noexcept;
+    void decode(const json &result) noexcept;
+
+    AssetPairs() noexcept = default;
+    ~AssetPairs() noexcept = default;
+    AssetPairs(const AssetPairs &source) = delete;
+    AssetPairs(AssetPairs &&source) = delete;
+    auto operator=(const AssetPairs &source) -> AssetPairs & = delete;
+    auto operator=(AssetPairs &&source) -> AssetPairs & = delete;
+
+private:
+    std::unordered_map<std::string, size_t> index{};
+    // Asset code without Kraken's X/Z prefix to pair, order minimum and tradeable flag
+    std::unordered_map<std::string, AssetInfo> assets{};
+
+    static auto assetCode(const std::string &asset) noexcept -> std::string;
+    void buildAssets() noexcept;
+
+    void addPair(const std::string &ticker, const std::string &base, const double &minimum, const int &priceDecimal, const int &volumeDecimal) noexcept;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "scheduler.h"
+
+#include <csignal>
+#include <pthread.h>
+
+static auto shutdownSignals() noexcept -> sigset_t
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    return set;
+}
+
+Scheduler::Scheduler() noexcept
+{
+    sigset_t set(shutdownSignals());
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    signals = std::thread([this, set]() {
+        int received(0);
+        sigwait(&set, &received);
+        requestShutdown(received == SIGINT ? "Signal SIGINT received." : "Signal SIGTERM received.");
+    });
+}
+
+Scheduler::~Scheduler() noexcept
+{
+    requestShutdown("Program finished.");
+    pthread_kill(signals.native_handle(), SIGTERM);
+    signals.join();
+}
+
+auto Scheduler::waitFor(const long &seconds) noexcept -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_for(lock, std::chrono::seconds(seconds), [this]() { return shutdown; });
+    return !shutdown;
+}
+
+auto Scheduler::waitUntil(const std::chrono::steady_clock::time_point &deadline) noexcept -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_until(lock, deadline, [this]() { return shutdown; });
+    return !shutdown;
+}
+
+auto Scheduler::waitUntil(const std::chrono::steady_clock::time_point &deadline, const std::function<bool()> &woken) noexcept -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_until(lock, deadline, [this, &woken]() { return shutdown || woken(); });
+    return !shutdown;
+}
+
+void Scheduler::notify() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    wakeup.notify_all();
+}
+
+void Scheduler::waitShutdown() noexcept
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait(lock, [this]() { return shutdown; });
+}
+
+void Scheduler::requestShutdown(const std::string &why) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (shutdown)
+        {
+            return;
+        }
+        shutdown = true;
+        reason = why;
+    }
+    wakeup.notify_all();
+}
+
+auto Scheduler::stopping() noexcept -> bool
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return shutdown;
+}
+
+auto Scheduler::getReason() noexcept -> const std::string
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return reason;
+}
@@ -0,0 +1,54 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "config.h"
+#include "utils.h"
+
+class Scheduler
+{
+public:
+    auto waitFor(const long &seconds) noexcept -> bool;
+    auto waitUntil(const std::chrono::steady_clock::time_point &deadline) noexcept -> bool;
+    auto waitUntil(const std::chrono::steady_clock::time_point &deadline, const std::function<bool()> &woken) noexcept -> bool;
+    void notify() noexcept;
+    void waitShutdown() noexcept;
+    void requestShutdown(const std::string &why) noexcept;
+    auto stopping() noexcept -> bool;
+    auto getReason() noexcept -> const std::string;
+
+    Scheduler() noexcept;
+    ~Scheduler() noexcept;
+    Scheduler(const Scheduler &source) = delete;
+    Scheduler(Scheduler &&source) = delete;
+    auto operator=(const Scheduler &source) -> Scheduler & = delete;
+    auto operator=(Scheduler &&source) -> Scheduler & = delete;
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool shutdown{false};
+    std::string reason{};
+
+    std::thread signals;
+};
+
+#endif
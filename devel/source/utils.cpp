@@ -73,6 +73,32 @@ auto vec2str(const std::vector<std::string> &input) noexcept -> std::string
     return result.str();
 }
 
+auto state2str(const OrderState &state) noexcept -> std::string
+{
+    switch (state)
+    {
+    case OrderState::Pending:
+        return "pending";
+    case OrderState::Open:
+        return "open";
+    case OrderState::Partial:
+        return "partial";
+    case OrderState::Closed:
+        return "closed";
+    case OrderState::Cancelled:
+        return "cancelled";
+    case OrderState::Expired:
+        return "expired";
+    default:
+        return "unknown";
+    }
+}
+
+auto isFinal(const OrderState &state) noexcept -> bool
+{
+    return state == OrderState::Closed || state == OrderState::Cancelled || state == OrderState::Expired;
+}
+
 auto compareTradePipeline(const Trade &first, const Trade &second) -> bool
 {
     double pvFirst(first.quantity * first.price);
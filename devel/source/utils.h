@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -32,6 +33,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <atomic>
 #include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+
+enum class OrderState
+{
+    Pending,
+    Open,
+    Partial,
+    Closed,
+    Cancelled,
+    Expired
+};
 
 struct Trade
 {
@@ -41,10 +57,20 @@ struct Trade
     double quantity{};
     double price{};
     double limit{0.0};
+    double filled{0.0};
+    OrderState state{OrderState::Pending};
     bool executed{false};
     bool placed{false};
 };
 
+struct Fill
+{
+    std::string ticker;
+    std::string txid;
+    double quantity{};
+    double price{};
+};
+
 #define bool2str(input) ((input) ? "true" : "false")
 
 void getSystemTime(long &data) noexcept;
@@ -54,6 +80,9 @@ auto time2str(const long &unixtime) noexcept -> std::string;
 auto num2str(const double &number, const int &precision) noexcept -> std::string;
 auto vec2str(const std::vector<std::string> &input) noexcept -> std::string;
 
+auto state2str(const OrderState &state) noexcept -> std::string;
+auto isFinal(const OrderState &state) noexcept -> bool;
+
 auto compareTradePipeline(const Trade &first, const Trade &second) -> bool;
 
 #endif
@@ -23,15 +23,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "kraken.h"
 #include "asset.h"
+#include "book.h"
+#include "market.h"
+#include "pipeline.h"
 #include "portfolio.h"
 #include "utils.h"
 #include "optimizer.h"
+#include "predict.h"
+#include "scheduler.h"
+#include "sink.h"
+#include "watcher.h"
 #include "config.h"
 
-// Main function of ACCPO logic
-void accpo() noexcept;
+// Main function of ACCPO logic - runs until shutdown is requested from "scheduler"
+void accpo(Scheduler &scheduler) noexcept;
 
 // Main function of executable
-auto main() -> int;
+auto main(int argc, char *argv[]) -> int;
 
 #endif
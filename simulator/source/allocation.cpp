@@ -0,0 +1,61 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "allocation.h"
+
+#ifdef ACCPO_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations{0};
+
+// Array and nothrow variants of operator new forward to this one
+auto operator new(std::size_t size) -> void *
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t /*size*/) noexcept
+{
+    std::free(memory);
+}
+
+auto allocation_count() noexcept -> size_t
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+auto allocation_count() noexcept -> size_t
+{
+    return 0;
+}
+
+#endif
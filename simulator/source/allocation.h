@@ -0,0 +1,35 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ALLOCATION_H
+#define ALLOCATION_H
+
+#include "utils.h"
+
+// Counter of heap allocations - used to check that hot loops do not allocate
+// Counting replaces global operator new and is only compiled in with ACCPO_COUNT_ALLOCATIONS
+#ifdef ACCPO_COUNT_ALLOCATIONS
+inline constexpr bool allocations_counted{true};
+#else
+inline constexpr bool allocations_counted{false};
+#endif
+
+// Return number of heap allocations since program start - always zero if not counted
+auto allocation_count() noexcept -> size_t;
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "analytics.h"
+
+void Analytics::update(const long &time, const double &pv, const double &traded, const double &fees, const double &exposure) noexcept
+{
+    if (steps == 0)
+    {
+        time_first = time;
+        pv_first = pv;
+        peak = pv;
+    }
+    else
+    {
+        double step_return(pv / pv_last - 1.0);
+        auto returns(static_cast<double>(steps));
+        double delta(step_return - mean);
+        mean += delta / returns;
+        squares += delta * (step_return - mean);
+        downside += step_return < 0.0 ? step_return * step_return : 0.0;
+
+        total_turnover += traded / pv_last;
+        total_fees += fees;
+    }
+
+    steps++;
+    time_last = time;
+    pv_last = pv;
+    peak = std::max(peak, pv);
+    max_drawdown = std::max(max_drawdown, 1.0 - pv / peak);
+    exposure_sum += exposure;
+}
+
+auto Analytics::volatility() const noexcept -> double
+{
+    // One return less than steps
+    return steps > 2 ? sqrt(std::max(0.0, squares / static_cast<double>(steps - 2))) : 0.0;
+}
+
+auto Analytics::sharpe() const noexcept -> double
+{
+    double deviation(volatility());
+    return deviation > 0.0 ? mean / deviation * sqrt(steps_per_year()) : 0.0;
+}
+
+auto Analytics::sortino() const noexcept -> double
+{
+    double deviation(steps > 1 ? sqrt(downside / static_cast<double>(steps - 1)) : 0.0);
+    return deviation > 0.0 ? mean / deviation * sqrt(steps_per_year()) : 0.0;
+}
+
+auto Analytics::steps_per_year() const noexcept -> double
+{
+    auto interval(steps > 1 ? static_cast<double>(time_last - time_first) / static_cast<double>(steps - 1) : 0.0);
+    return interval > 0.0 ? 365.25 * 24.0 * 60.0 * 60.0 / interval : 0.0;
+}
+
+auto Analytics::output(const std::string &title) const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Analytics of " << title << " over " << std::to_string(steps) << " steps" << std::endl;
+    result << "Performance total:    " << num2str(100.0 * performance()) << " %" << std::endl;
+    result << "Volatility per step:  " << num2str(100.0 * volatility()) << " %" << std::endl;
+    result << "Sharpe ratio:         " << num2str(sharpe()) << std::endl;
+    result << "Sortino ratio:        " << num2str(sortino()) << std::endl;
+    result << "Max drawdown:         " << num2str(100.0 * drawdown()) << " %" << std::endl;
+    result << "Turnover:             " << num2str(turnover()) << std::endl;
+    result << "Fees paid:            " << num2str(fees()) << std::endl;
+    result << "Mean exposure:        " << num2str(100.0 * exposure()) << " %" << std::endl;
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
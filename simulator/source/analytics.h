@@ -0,0 +1,71 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for performance analytics accumulated in one streaming pass over a portfolio value series
+// Each step costs O(1) - usable for backtests over historic timebins as well as for every poll of the live loop
+class Analytics
+{
+public:
+    // Add one step - time and portfolio value after the step, value traded and fees paid in the step
+    // and exposure (weight of all non-riskfree assets) after the step - the first step only sets the start
+    void update(const long &time, const double &pv, const double &traded, const double &fees, const double &exposure) noexcept;
+
+    // Read out relative performance since start and sample volatility of the returns per step
+    [[nodiscard]] auto performance() const noexcept -> double { return steps > 0 ? pv_last / pv_first - 1.0 : 0.0; }
+    [[nodiscard]] auto volatility() const noexcept -> double;
+    // Read out Sharpe and Sortino ratio annualized from the mean time between steps - riskfree asset returns zero
+    [[nodiscard]] auto sharpe() const noexcept -> double;
+    [[nodiscard]] auto sortino() const noexcept -> double;
+    // Read out maximum drawdown, turnover relative to the portfolio value, fees paid and mean exposure
+    [[nodiscard]] auto drawdown() const noexcept -> double { return max_drawdown; }
+    [[nodiscard]] auto turnover() const noexcept -> double { return total_turnover; }
+    [[nodiscard]] auto fees() const noexcept -> double { return total_fees; }
+    [[nodiscard]] auto exposure() const noexcept -> double { return steps > 0 ? exposure_sum / static_cast<double>(steps) : 0.0; }
+
+    // Prints to the console all analytics under "title"
+    [[nodiscard]] auto output(const std::string &title) const noexcept -> const std::stringstream;
+
+private:
+    size_t steps{0};
+    long time_first{0};
+    long time_last{0};
+    double pv_first{0.0};
+    double pv_last{0.0};
+    double peak{0.0};
+
+    // Running mean and sum of squared deviations of the returns (Welford) and sum of squared negative returns
+    double mean{0.0};
+    double squares{0.0};
+    double downside{0.0};
+
+    double max_drawdown{0.0};
+    double total_turnover{0.0};
+    double total_fees{0.0};
+    double exposure_sum{0.0};
+
+    // Number of steps per year from the mean time between steps
+    [[nodiscard]] auto steps_per_year() const noexcept -> double;
+};
+
+#endif
@@ -25,15 +25,92 @@ auto Historic::value() const noexcept -> const std::vector<double>
     return result;
 }
 
+auto Historic::append(const Historic &bars, const long &period, const long &until) noexcept -> size_t
+{
+    size_t appended(0);
+    double hold(quantity.empty() ? 0.0 : quantity.back());
+    for (size_t bar(0); bar < bars.size(); bar++)
+    {
+        // Kraken includes bars already held and the bar still in progress - both are skipped
+        if ((!time.empty() && bars.time[bar] <= time.back()) || bars.time[bar] + period > until)
+        {
+            continue;
+        }
+        append_bar(bars, bar, hold);
+        appended++;
+    }
+    return appended;
+}
+
+auto Historic::append(const Historic &bars, const std::vector<long> &timebins) noexcept -> size_t
+{
+    size_t appended(0);
+    double hold(quantity.empty() ? 0.0 : quantity.back());
+    auto bar(bars.time.begin());
+    for (auto const &timebin : timebins)
+    {
+        bar = std::lower_bound(bar, bars.time.end(), timebin);
+        if (bar == bars.time.end())
+        {
+            break;
+        }
+        if (*bar == timebin)
+        {
+            append_bar(bars, static_cast<size_t>(std::distance(bars.time.begin(), bar)), hold);
+            appended++;
+        }
+    }
+    return appended;
+}
+
+void Historic::append_bar(const Historic &bars, const size_t &bar, const double &hold) noexcept
+{
+    time.emplace_back(bars.time[bar]);
+    open.emplace_back(bars.open[bar]);
+    high.emplace_back(bars.high[bar]);
+    low.emplace_back(bars.low[bar]);
+    close.emplace_back(bars.close[bar]);
+    vwap.emplace_back(bars.vwap[bar]);
+    volume.emplace_back(bars.volume[bar]);
+    count.emplace_back(bars.count[bar]);
+    quantity.emplace_back(hold);
+}
+
+auto common_timebins(const std::vector<const Historic *> &series, const long &after, const long &period, const long &until) noexcept -> std::vector<long>
+{
+    std::vector<long> timebins;
+    if (series.empty())
+    {
+        return timebins;
+    }
+
+    // Start from the timebins of the first series and drop every one missing in another series
+    for (auto const &timebin : series.front()->time)
+    {
+        if (timebin > after && timebin + period <= until)
+        {
+            timebins.emplace_back(timebin);
+        }
+    }
+    for (auto const &other : series)
+    {
+        auto missing = [&other](const long &timebin) { return !std::binary_search(other->time.begin(), other->time.end(), timebin); };
+        timebins.erase(std::remove_if(timebins.begin(), timebins.end(), missing), timebins.end());
+    }
+    return timebins;
+}
+
 Asset::Asset(std::string ticker) noexcept : name(std::move(ticker))
 {
-    current.reserve(CF.idx2str.size());
-    std::cout << "Asset constructor executed for: " << name << " with " << std::to_string(CF.idx2str.size()) << " currents." << std::endl;
+    current.resize(CF.idx2str.size());
+    marks = std::make_shared<DirtyMarks>();
+    marks->current.resize(CF.idx2str.size(), true);
+    LOG.debug("Asset constructor executed", {{"asset", name}, {"currents", CF.idx2str.size()}});
 }
 
 Asset::~Asset() noexcept
 {
-    std::cout << "Asset destructor executed for: " << name << std::endl;
+    LOG.debug("Asset destructor executed", {{"asset", name}});
 }
 
 void Asset::fill_historic_riskfree(const std::vector<long> &timebins) noexcept
@@ -47,8 +124,36 @@ void Asset::fill_historic_riskfree(const std::vector<long> &timebins) noexcept
     historic.volume = std::vector<double>(historic.size(), 0.0);
     historic.count = std::vector<long>(historic.size(), 0);
     historic.quantity = std::vector<double>(historic.size(), 0.0);
+    marks->historic_from = 0;
+
+    LOG.debug("Asset fill_riskfree_data() executed", {{"asset", name}});
+}
 
-    std::cout << "Asset fill_riskfree_data() executed for: " << name << std::endl;
+auto Asset::append_historic(const Historic &bars, const std::vector<long> &timebins) noexcept -> size_t
+{
+    size_t from(historic.size());
+    size_t appended(historic.append(bars, timebins));
+    marks->historic_from = std::min(marks->historic_from, from);
+    return appended;
+}
+
+void Asset::append_historic_riskfree(const std::vector<long> &timebins) noexcept
+{
+    size_t from(historic.size());
+    double hold(historic.quantity.empty() ? 0.0 : historic.quantity.back());
+    for (size_t ti(from); ti < timebins.size(); ti++)
+    {
+        historic.time.emplace_back(timebins[ti]);
+        historic.open.emplace_back(1.0);
+        historic.high.emplace_back(1.0);
+        historic.low.emplace_back(1.0);
+        historic.close.emplace_back(1.0);
+        historic.vwap.emplace_back(1.0);
+        historic.volume.emplace_back(0.0);
+        historic.count.emplace_back(0);
+        historic.quantity.emplace_back(hold);
+    }
+    marks->historic_from = std::min(marks->historic_from, from);
 }
 
 void Asset::set_current_riskfree(const size_t &which) noexcept
@@ -57,12 +162,23 @@ void Asset::set_current_riskfree(const size_t &which) noexcept
     current[which].bid = 1.0;
     current[which].price = 1.0;
     get_system_time(current[which].time);
+    marks->current[which] = true;
+}
+
+void Asset::set_current_prices(const Current &data, const size_t &which) noexcept
+{
+    current[which].time = data.time;
+    current[which].ask = data.ask;
+    current[which].bid = data.bid;
+    current[which].price = data.price;
+    marks->current[which] = true;
 }
 
 void Asset::set_historic_quantity(const double &quantity, const size_t &idx) noexcept
 {
     historic.quantity[idx] = quantity;
     std::fill(historic.quantity.begin() + static_cast<long>(idx), historic.quantity.end(), quantity);
+    marks->historic_from = std::min(marks->historic_from, idx);
 }
 
 void Asset::copy_current_data(const size_t &source, const size_t &dest) noexcept
@@ -72,6 +188,7 @@ void Asset::copy_current_data(const size_t &source, const size_t &dest) noexcept
     current[dest].bid = current[source].bid;
     current[dest].price = current[source].price;
     current[dest].quantity = current[source].quantity;
+    marks->current[dest] = true;
 }
 
 auto Asset::current_output_state(const double &pv, const size_t &which) const noexcept -> const std::stringstream
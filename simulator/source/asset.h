@@ -40,6 +40,13 @@ struct Historic
     std::vector<double> quantity;
     // Calculate value of asset vector
     [[nodiscard]] auto value() const noexcept -> const std::vector<double>;
+    // Append all bars of "bars" later than the last timebin and complete ("period" seconds long and ended before "until")
+    // Appended timebins hold the last quantity - returns number of bars appended
+    auto append(const Historic &bars, const long &period, const long &until) noexcept -> size_t;
+    // Append the bars of "bars" at "timebins" (ascending and later than the last timebin) - returns number of bars appended
+    auto append(const Historic &bars, const std::vector<long> &timebins) noexcept -> size_t;
+    // Append bar number "bar" of "bars" holding "hold" as quantity
+    void append_bar(const Historic &bars, const size_t &bar, const double &hold) noexcept;
     // Return data at single index position
     [[nodiscard]] auto idx_time(const size_t &idx) const noexcept -> long { return time[idx]; }
     [[nodiscard]] auto idx_price(const size_t &idx) const noexcept -> double { return vwap[idx]; }
@@ -47,6 +54,9 @@ struct Historic
     [[nodiscard]] auto idx_quantity(const size_t &idx) const noexcept -> double { return quantity[idx]; }
 };
 
+// Timebins held by every one of "series" that are later than "after" and complete ("period" seconds long and ended before "until")
+[[nodiscard]] auto common_timebins(const std::vector<const Historic *> &series, const long &after, const long &period, const long &until) noexcept -> std::vector<long>;
+
 // Struct for storing one-time ticker information
 struct Current
 {
@@ -59,6 +69,16 @@ struct Current
     [[nodiscard]] auto value() const noexcept -> double { return price*quantity; }
 };
 
+// Struct for marking cached aggregates of a portfolio as outdated - shared by the portfolio and all its assets
+// Setters of quantities and prices mark, the portfolio recalculates marked aggregates on the next read only
+struct DirtyMarks
+{
+    // Historic aggregates from this timebin onwards are outdated
+    size_t historic_from{0};
+    // Aggregates of element "which" in current vector are outdated
+    std::vector<bool> current;
+};
+
 // Class for storing, accessing and manipulating one single cryptocurrency
 class Asset
 {
@@ -81,11 +101,22 @@ public:
     // Set data of element "which" in one-time ticker information vector to riskfree data
     void set_current_riskfree(const size_t &which) noexcept;
 
+    // Append the bars at "timebins" newer than the last timebin - returns number of bars appended
+    auto append_historic(const Historic &bars, const std::vector<long> &timebins) noexcept -> size_t;
+    // Append riskfree data for all "timebins" beyond the timebins already held
+    void append_historic_riskfree(const std::vector<long> &timebins) noexcept;
+
 
     // Sets the historic quantity of this asset hold at index idx and beyond
     void set_historic_quantity(const double &quantity, const size_t &idx) noexcept;
     // Set data of element "which" in one-time ticker information to data struct
-    void set_current_quantity(const double &quantity, const size_t &which) noexcept { current[which].quantity = quantity; }
+    void set_current_quantity(const double &quantity, const size_t &which) noexcept
+    {
+        current[which].quantity = quantity;
+        marks->current[which] = true;
+    }
+    // Set time and prices of element "which" in one-time ticker information from data struct - keeps quantity
+    void set_current_prices(const Current &data, const size_t &which) noexcept;
 
     // Copy element in current vector from "source" location to "dest" location
     void copy_current_data(const size_t &source, const size_t &dest) noexcept;
@@ -95,14 +126,21 @@ public:
     // Prints to the console the changes in quantities (from optimization) between "before" and "after"
     [[nodiscard]] auto current_output_trade(const size_t &before, const size_t &after) const noexcept -> const std::stringstream;
 
+    // Report all further changes of quantities and prices into "shared" - called when added to a portfolio
+    void share_marks(std::shared_ptr<DirtyMarks> shared) noexcept { marks = std::move(shared); }
+
     // Variable to store entire historic OHLC data
     Historic historic;
     // Vector of single one-time ticker informations
+    // Write quantities and prices through the setters only - otherwise portfolio aggregates become outdated
     std::vector<Current> current;
 
 private:
     // Name of asset
     std::string name;
+
+    // Marks of outdated aggregates - private until the asset is added to a portfolio
+    std::shared_ptr<DirtyMarks> marks;
 };
 
 #endif
@@ -0,0 +1,74 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "attribution.h"
+
+Attribution::Attribution(const size_t &assets) noexcept
+    : initial(assets, 0.0), held(assets, 0.0), last_prices(assets, 0.0),
+      market_pnl(assets, 0.0), rebalance_pnl(assets, 0.0), costs_paid(assets, 0.0)
+{
+}
+
+void Attribution::start(const std::vector<double> &quantities, const std::vector<double> &prices) noexcept
+{
+    std::copy(quantities.begin(), quantities.end(), initial.begin());
+    std::copy(quantities.begin(), quantities.end(), held.begin());
+    std::copy(prices.begin(), prices.end(), last_prices.begin());
+    std::fill(market_pnl.begin(), market_pnl.end(), 0.0);
+    std::fill(rebalance_pnl.begin(), rebalance_pnl.end(), 0.0);
+    std::fill(costs_paid.begin(), costs_paid.end(), 0.0);
+}
+
+void Attribution::update(const std::vector<double> &quantities, const std::vector<double> &prices) noexcept
+{
+    for (size_t asset(0); asset < held.size(); asset++)
+    {
+        double move(prices[asset] - last_prices[asset]);
+        market_pnl[asset] += initial[asset] * move;
+        rebalance_pnl[asset] += (held[asset] - initial[asset]) * move;
+
+        // Fees are paid from the riskfree asset but charged to the traded asset - same fee as in rebalancing
+        if (asset != Configuration::RF)
+        {
+            costs_paid[asset] += fabs(quantities[asset] - held[asset]) * prices[asset] * CF.trade_fee;
+        }
+
+        held[asset] = quantities[asset];
+        last_prices[asset] = prices[asset];
+    }
+}
+
+auto Attribution::output(const std::vector<std::string> &names, const std::string &title) const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Attribution of profit and loss of " << title << std::endl;
+    for (size_t asset(0); asset < held.size(); asset++)
+    {
+        result << names[asset];
+        result << "   Market: " << num2str(market(asset));
+        result << "   Rebalance: " << num2str(rebalance(asset));
+        result << "   Costs: " << num2str(costs(asset));
+        result << "   Contribution: " << num2str(contribution(asset));
+        result << std::endl;
+    }
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
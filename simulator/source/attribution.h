@@ -0,0 +1,63 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ATTRIBUTION_H
+#define ATTRIBUTION_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for running attribution of the profit and loss of a portfolio to its assets
+// Change in portfolio value is split per asset into:
+//     market    - price moves on the quantity held at start (buy and hold)
+//     rebalance - price moves on the quantity bought or sold by all rebalancings since start
+//     costs     - fees paid for trading the asset
+// Each step costs O(assets) - usable for every historic timebin as well as for every poll of the live loop
+class Attribution
+{
+public:
+    // Constructor - takes number of assets (riskfree first)
+    explicit Attribution(const size_t &assets) noexcept;
+
+    // Start from held quantities and prices - resets all profits and losses
+    void start(const std::vector<double> &quantities, const std::vector<double> &prices) noexcept;
+    // Add one step - prices moved to "prices" on the held quantities, then the portfolio was rebalanced to "quantities"
+    void update(const std::vector<double> &quantities, const std::vector<double> &prices) noexcept;
+
+    // Read out running profit and loss of one asset
+    [[nodiscard]] auto market(const size_t &asset) const noexcept -> double { return market_pnl[asset]; }
+    [[nodiscard]] auto rebalance(const size_t &asset) const noexcept -> double { return rebalance_pnl[asset]; }
+    [[nodiscard]] auto costs(const size_t &asset) const noexcept -> double { return costs_paid[asset]; }
+    [[nodiscard]] auto contribution(const size_t &asset) const noexcept -> double { return market_pnl[asset] + rebalance_pnl[asset] - costs_paid[asset]; }
+    [[nodiscard]] auto number_assets() const noexcept -> size_t { return held.size(); }
+
+    // Prints to the console the attribution of all assets with their "names" under "title"
+    [[nodiscard]] auto output(const std::vector<std::string> &names, const std::string &title) const noexcept -> const std::stringstream;
+
+private:
+    // Quantities at start and held since the last step, prices of the last step
+    std::vector<double> initial;
+    std::vector<double> held;
+    std::vector<double> last_prices;
+
+    std::vector<double> market_pnl;
+    std::vector<double> rebalance_pnl;
+    std::vector<double> costs_paid;
+};
+
+#endif
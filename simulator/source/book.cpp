@@ -0,0 +1,324 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "book.h"
+
+Book::Book(BookConfig book, const Snapshot &snapshot) noexcept
+    : config(std::move(book))
+{
+    // Tickers fetched at different times start at different bars - only timebins held by every ticker are used
+    std::vector<const Historic *> series;
+    for (auto const &name : config.assets_names)
+    {
+        series.emplace_back(&snapshot.bars.at(name));
+    }
+    std::vector<long> timebins(common_timebins(series, std::numeric_limits<long>::min(), 0, std::numeric_limits<long>::max()));
+
+    // Create vector of assets of non-riskfree assets
+    std::vector<std::unique_ptr<Asset>> asset_vector;
+    for (size_t asset(0); asset < config.assets_names.size(); asset++)
+    {
+        // Create new asset
+        std::unique_ptr<Asset> new_asset = std::make_unique<Asset>(config.assets_names[asset]);
+
+        // Fill asset with historic data from the snapshot
+        new_asset->historic.append(*series[asset], timebins);
+        // Set quantity of asset
+        new_asset->set_historic_quantity(config.asset_quantities[asset], 0);
+
+        // Move asset into asset vector
+        asset_vector.push_back(std::move(new_asset));
+    }
+
+    // Create a riskfree asset
+    std::unique_ptr<Asset> RiskFree = std::make_unique<Asset>(CF.riskfree_name);
+    // Use same timebins as in non-riskfree assets
+    RiskFree->fill_historic_riskfree(timebins);
+    // Set quantity of riskfree
+    RiskFree->set_historic_quantity(config.riskfree_quantity, 0);
+
+    // Set the initial current struct to latest data
+    // For Riskfree
+    RiskFree->set_current_riskfree(CF.INI);
+    for (auto const &asset : asset_vector)
+    {
+        // For all non-riskfree assets
+        asset->set_current_prices(snapshot.get_current(asset->get_name()), CF.INI);
+    }
+
+    // Create a portfolio and set riskfree asset as first element
+    P = std::make_shared<Portfolio>(std::move(RiskFree));
+    RiskFree = nullptr;
+    for (auto &asset : asset_vector)
+    {
+        // Add all other assets int the portfolio
+        P->add_asset(std::move(asset));
+        asset = nullptr;
+    }
+
+    // Initialize an instance of the optimizer for the configured strategy and put the portfolio into it
+    O = make_optimizer(config.strategy, P);
+    attribution = Attribution(P->number_assets());
+    quantities = std::vector<double>(P->number_assets(), 0.0);
+    prices = std::vector<double>(P->number_assets(), 0.0);
+    for (auto const &asset : P->assets)
+    {
+        names.emplace_back(asset->get_name());
+    }
+
+    LOG.info("Book constructor executed", {{"book", config.name}, {"timebins", timebins.size()}});
+}
+
+Book::~Book() noexcept
+{
+    LOG.info("Book destructor executed", {{"book", config.name}});
+}
+
+void Book::initialize() noexcept
+{
+    LOG.text("###############################################################################################################\n"
+             "Initializing book: " + config.name + " (strategy: " + config.strategy + ")\n");
+
+    // Perform optimization on historic data
+    O->history_calculate();
+    // Output the historic state after optimization - before it every timebin only repeats the initial quantities
+    Report report;
+    P->history_output(report, 0, P->number_timebins() - 1);
+    LOG.text(O->get_history_analytics().output("historic backtest").str());
+    LOG.text(O->get_history_attribution().output(names, "historic backtest").str());
+
+    // Backtests only read the portfolio - they run concurrently on the shared pool and are printed in fixed order
+    // Validate the strategy out-of-sample on rolling windows of historic data
+    std::future<WalkForward> walk;
+    if (CF.walk_test > 0)
+    {
+        walk = POOL.submit(Priority::Normal, [this]() { return O->walk_forward(static_cast<size_t>(CF.walk_train), static_cast<size_t>(CF.walk_test)); });
+    }
+
+    // Assess tail risk of the strategy on synthetic paths generated from the historic returns
+    std::unique_ptr<Scenario> scenario;
+    std::future<ScenarioResult> paths;
+    if (CF.mc_paths > 0)
+    {
+        scenario = std::make_unique<Scenario>(O->get_returns(), P->number_timebins(), P->number_assets(), CF.mc_method, static_cast<size_t>(CF.mc_block));
+        paths = POOL.submit(Priority::Normal, [this, &scenario]() { return O->monte_carlo(*scenario, static_cast<size_t>(CF.mc_paths), static_cast<size_t>(CF.mc_length)); });
+    }
+
+    // Replay recorded ticker snapshots through the same rebalancing as the polling loop
+    std::unique_ptr<TickReplay> replay;
+    std::future<TickResult> ticks;
+    if (CF.tick_file != CF.no_file)
+    {
+        replay = std::make_unique<TickReplay>(CF.tick_file, names);
+        if (replay->size() > 0)
+        {
+            ticks = POOL.submit(Priority::Normal, [this, &replay]() { return O->tick_backtest(*replay); });
+        }
+    }
+
+    if (walk.valid())
+    {
+        LOG.text(POOL.wait(walk).output().str());
+    }
+    if (paths.valid())
+    {
+        LOG.text(POOL.wait(paths).output().str());
+    }
+    if (ticks.valid())
+    {
+        LOG.text(POOL.wait(ticks).output().str());
+    }
+
+    // Initialize the current structs of all assets
+    O->current_initialize(config.riskfree_quantity, config.asset_quantities);
+
+    // Output the initial current state before any optimization
+    LOG.text(P->current_output_state(CF.INI).str());
+    // Optimize and output the potential trades for a balanced current
+    LOG.text(P->current_output_trade(CF.INI, CF.BAL).str());
+    // Output the balanced current state after optimization
+    LOG.text(P->current_output_state(CF.BAL).str());
+
+    // Live analytics and attribution start from the balanced current
+    record_step(CF.INI, CF.BAL);
+    P->current_fill_quantities(CF.BAL, quantities);
+    P->current_fill_prices(CF.BAL, prices);
+    attribution.start(quantities, prices);
+}
+
+auto Book::update(const Snapshot &snapshot, std::vector<Record> &records) noexcept -> std::string
+{
+    std::stringstream text;
+    text << "###############################################################################################################" << std::endl;
+    text << "Book: " << config.name << " (strategy: " << config.strategy << ")" << std::endl;
+
+    // New bars are added to the history before trading so that the strategy predicts from the latest bar
+    if (!snapshot.bars.empty())
+    {
+        text << "Appended " << std::to_string(append_bars(snapshot.bars)) << " new historic bars." << std::endl;
+    }
+
+    if (snapshot.iteration > 1)
+    {
+        for (auto &asset : P->assets)
+        {
+            // We move the lastest current struct into the balanced current struct
+            // Since we are using logic with three currents (initial, balanced and latest)
+            asset->copy_current_data(CF.LAT, CF.BAL);
+        }
+    }
+
+    // Set the latest current for the riskfree asset
+    P->assets[CF.RF]->set_current_riskfree(CF.LAT);
+
+    // Fill current with latest ticker information from the snapshot for all non-riskfree assets
+    for (size_t asset(1); asset < P->number_assets(); asset++)
+    {
+        P->assets[asset]->set_current_prices(snapshot.get_current(P->assets[asset]->get_name()), CF.LAT);
+    }
+
+    std::stringstream output_buffer = P->current_output_performance(CF.INI, CF.LAT);
+
+    text << P->current_output_state(CF.INI).str();
+    text << P->current_output_trade(CF.INI, CF.BAL).str();
+    text << P->current_output_state(CF.BAL).str();
+    O->current_update(CF.BAL, CF.LAT);
+    text << P->current_output_trade(CF.BAL, CF.LAT).str();
+    text << P->current_output_state(CF.LAT).str();
+
+    text << output_buffer.str();
+    record_step(CF.BAL, CF.LAT);
+    text << live.output("live trading").str();
+    text << attribution.output(names, "live trading").str();
+    publish(snapshot.iteration, records);
+
+    long last_time(P->idx_time(P->number_timebins() - 1));
+    text << "Last historic time was: " << time2str(last_time) << std::endl;
+
+    // Last historic bar is complete - the following bar is published once it has run for a full interval
+    double next_historic(2.0 * std::stod(CF.interval) - static_cast<double>(P->current_time(CF.LAT) - last_time) / 60.0);
+
+    text << "New historic data will become available in: ";
+    text << std::to_string(next_historic) << " minutes (interval = " << CF.interval << " minutes)." << std::endl;
+
+    return text.str();
+}
+
+auto Book::append_bars(const std::map<std::string, Historic> &bars) noexcept -> size_t
+{
+    // A book holding only the riskfree asset has no bars to follow
+    if (P->number_assets() < 2)
+    {
+        return 0;
+    }
+    long period(60 * std::stol(CF.interval));
+
+    // Bars not yet published for every asset of the book wait for the next refresh
+    long until(std::numeric_limits<long>::max());
+    std::vector<const Historic *> series;
+    for (size_t asset(1); asset < P->number_assets(); asset++)
+    {
+        series.emplace_back(&bars.at(P->assets[asset]->get_name()));
+        until = std::min(until, series.back()->time.back() + period);
+    }
+
+    // Only timebins published for every asset are appended - all assets keep equal length
+    std::vector<long> timebins(common_timebins(series, P->assets[1]->historic.time.back(), period, until));
+    for (size_t asset(1); asset < P->number_assets(); asset++)
+    {
+        P->assets[asset]->append_historic(*series[asset - 1], timebins);
+    }
+    P->assets[CF.RF]->append_historic_riskfree(P->assets[1]->historic.time);
+
+    if (!timebins.empty())
+    {
+        O->history_extend();
+    }
+    return timebins.size();
+}
+
+void Book::record_step(const size_t &before, const size_t &after) noexcept
+{
+    double traded(0.0);
+    for (size_t asset(1); asset < P->number_assets(); asset++)
+    {
+        traded += fabs(P->assets[asset]->current[after].quantity - P->assets[asset]->current[before].quantity) * P->assets[asset]->current[after].price;
+    }
+
+    live.update(P->current_time(after), P->current_total_value(after), traded, traded * CF.trade_fee, 1.0 - P->current_weight(CF.RF, after));
+
+    P->current_fill_quantities(after, quantities);
+    P->current_fill_prices(after, prices);
+    attribution.update(quantities, prices);
+}
+
+void Book::publish(const long &iteration, std::vector<Record> &records) const noexcept
+{
+    Record record;
+    record.set_book(config.name);
+    record.iteration = iteration;
+    record.time = P->current_time(CF.LAT);
+
+    for (size_t asset(0); asset < P->number_assets(); asset++)
+    {
+        const Current &before(P->assets[asset]->current[CF.BAL]);
+        const Current &after(P->assets[asset]->current[CF.LAT]);
+        record.set_asset(P->assets[asset]->get_name());
+
+        record.kind = 'S';
+        record.value = after.value();
+        record.weight = P->current_weight(asset, CF.LAT);
+        record.quantity = after.quantity;
+        record.price = after.price;
+        record.fee = 0.0;
+        records.push_back(record);
+
+        record.kind = 'T';
+        record.quantity = after.quantity - before.quantity;
+        record.value = record.quantity * after.price;
+        record.weight = 0.0;
+        record.fee = asset == CF.RF ? 0.0 : fabs(record.value) * CF.trade_fee;
+        records.push_back(record);
+    }
+
+    for (size_t asset(0); asset < P->number_assets(); asset++)
+    {
+        record.set_asset(names[asset]);
+        record.kind = 'A';
+        record.value = attribution.contribution(asset);
+        record.weight = 0.0;
+        record.quantity = 0.0;
+        record.price = 0.0;
+        record.fee = attribution.costs(asset);
+        record.market = attribution.market(asset);
+        record.rebalance = attribution.rebalance(asset);
+        records.push_back(record);
+    }
+
+    record.kind = 'P';
+    record.market = 0.0;
+    record.rebalance = 0.0;
+    record.set_asset("");
+    record.value = P->current_total_value(CF.LAT);
+    record.weight = P->current_total_weight(CF.LAT);
+    record.quantity = 0.0;
+    record.price = 0.0;
+    record.fee = 0.0;
+    record.performance = 100.0 * (record.value / P->current_total_value(CF.INI) - 1.0);
+    records.push_back(record);
+}
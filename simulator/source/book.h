@@ -0,0 +1,82 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "analytics.h"
+#include "asset.h"
+#include "attribution.h"
+#include "config.h"
+#include "market.h"
+#include "optimizer.h"
+#include "portfolio.h"
+#include "predict.h"
+#include "sink.h"
+#include "utils.h"
+
+// Class for one client book - a portfolio with its own assets, quantities and strategy
+// Market data is never fetched by a book but copied from the shared store
+class Book
+{
+public:
+    // Constructor - takes configuration of book and builds portfolio from the historic data and tickers of "snapshot"
+    // Snapshot must carry historic data - the first snapshot after fetching historic data does
+    explicit Book(BookConfig book, const Snapshot &snapshot) noexcept;
+    // Destructor - clean up
+    ~Book() noexcept;
+    // Dummies to comply with Rule of Five
+    Book(const Book &source) = delete;
+    Book(Book &&source) = delete;
+    auto operator=(const Book &source) -> Book & = delete;
+    auto operator=(Book &&source) -> Book & = delete;
+
+    // Optimize and validate on historic data, then initialize and output the current structs
+    void initialize() noexcept;
+    // One iteration of the polling loop on the ticker information of "snapshot" - appends its sink records to "records"
+    // Returns the output of the iteration instead of printing it - books of one iteration are updated concurrently
+    [[nodiscard]] auto update(const Snapshot &snapshot, std::vector<Record> &records) noexcept -> std::string;
+
+    // Return name of book
+    [[nodiscard]] auto get_name() const noexcept -> const std::string { return config.name; }
+
+private:
+    BookConfig config;
+    std::shared_ptr<Portfolio> P;
+    std::unique_ptr<Optimizer> O;
+
+    // Analytics and attribution of profit and loss of the live trading - one step per poll
+    Analytics live;
+    Attribution attribution{0};
+    // Names, quantities and prices of all assets - buffers for the steps of the attribution
+    std::vector<std::string> names;
+    std::vector<double> quantities;
+    std::vector<double> prices;
+
+    // Append the bars of "bars" that are complete for all assets of the book and step the strategy on them
+    // Returns number of bars appended
+    auto append_bars(const std::map<std::string, Historic> &bars) noexcept -> size_t;
+
+    // Add the rebalancing from current "before" to "after" as one step to the live analytics and attribution
+    void record_step(const size_t &before, const size_t &after) noexcept;
+
+    // Publish state, trade and attribution of every asset and performance of the book for the latest current
+    void publish(const long &iteration, std::vector<Record> &records) const noexcept;
+};
+
+#endif
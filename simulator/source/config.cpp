@@ -22,95 +22,380 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 Configuration::Configuration() noexcept
 {
-    // Read file entries - final values
-    read_parameter(apikey, "API_KEY");
-    read_parameter(seckey, "SEC_KEY");
-    read_parameter(riskfree_quantity, "RISKFREE_QUANTITY");
-    read_parameter(interval, "INTERVAL");
-    read_parameter(trade_fee, "TRADE_FEE");
-    read_parameter(weight_diff, "WEIGHT_DIFF");
-    read_parameter(pause_api, "PAUSE_API");
-    read_parameter(pause_program, "PAUSE_PROG");
-    read_parameter(asset_list, "ASSET_LIST");
-
-    // Read file entries - to be processed further
+    LOG.info("Configuration constructor executed");
+}
+
+Configuration::~Configuration() noexcept
+{
+    LOG.info("Configuration destructor executed");
+}
+
+auto Configuration::load(int argc, char *argv[]) noexcept -> bool
+{
+    static constexpr double unbounded{std::numeric_limits<double>::max()};
+
+    // Typed schema of all single-valued parameters fixed at startup with their valid ranges or values
     std::string inputtime;
+    const std::vector<Parameter> schema{{"API_KEY", &apikey, 0.0, 0.0},
+                                        {"SEC_KEY", &seckey, 0.0, 0.0},
+                                        {"RISKFREE_QUANTITY", &riskfree_quantity, 0.0, unbounded},
+                                        {"STARTTIME", &inputtime, 0.0, 0.0},
+                                        {"INTERVAL", &interval, 0.0, 0.0},
+                                        {"TRADE_FEE", &trade_fee, 0.0, 1.0},
+                                        {"PAUSE_API", &pause_api, 0.0, 3600.0},
+                                        {"BAR_DELAY", &bar_delay, 0.0, 86400.0},
+                                        {"STRATEGY", &strategy, 0.0, 0.0, &strategies},
+                                        {"HRP_LOOKBACK", &hrp_lookback, 2.0, unbounded},
+                                        {"HRP_TOLERANCE", &hrp_tolerance, 0.0, 2.0},
+                                        {"WALK_TRAIN", &walk_train, 1.0, unbounded},
+                                        {"WALK_TEST", &walk_test, 0.0, unbounded},
+                                        {"MC_METHOD", &mc_method, 0.0, 0.0, &mc_methods},
+                                        {"MC_PATHS", &mc_paths, 0.0, unbounded},
+                                        {"MC_LENGTH", &mc_length, 1.0, unbounded},
+                                        {"MC_BLOCK", &mc_block, 1.0, unbounded},
+                                        {"TICK_FILE", &tick_file, 0.0, 0.0},
+                                        {"SINK_FORMAT", &sink_format, 0.0, 0.0},
+                                        {"SINK_PATH", &sink_path, 0.0, 0.0},
+                                        {"SINK_ROTATE", &sink_rotate, 1.0, unbounded},
+                                        {"AVAILABLE_TICKERS", &available_tickers, 0.0, 0.0}};
 
-    std::string asset_quants;
-    read_parameter(asset_quants, "ASSET_QUANTITIES");
-    read_parameter(inputtime, "STARTTIME");
+    // Overrides from environment and command line - later ones replace earlier ones
+    path = configfile;
+    if (const char *value = std::getenv("ACCPO_CONFIG"))
+    {
+        path = value;
+    }
+    std::vector<std::string> keys{"WEIGHT_DIFF", "PAUSE_PROG", "ASSET_LIST", "ASSET_QUANTITIES"};
+    for (auto const &parameter : schema)
+    {
+        keys.emplace_back(parameter.key);
+    }
+    for (auto const &key : keys)
+    {
+        if (const char *value = std::getenv(("ACCPO_" + key).c_str()))
+        {
+            overrides[key] = value;
+        }
+    }
+    for (int index(1); index < argc; index++)
+    {
+        std::string argument(argv[index]);
+        size_t equal(argument.find('='));
+        if (argument.compare(0, 2, "--") != 0 || equal == std::string::npos)
+        {
+            LOG.error("Command line argument is not of format --KEY=value", {{"argument", argument}});
+            return false;
+        }
+        std::string key(argument.substr(2, equal - 2));
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char letter) { return static_cast<char>(std::toupper(letter)); });
+        if (key == "CONFIG")
+        {
+            path = argument.substr(equal + 1);
+        }
+        else
+        {
+            overrides[key] = argument.substr(equal + 1);
+        }
+    }
 
-    // Set-up list of names of portfolio assets
-    std::stringstream stream_asset_list(asset_list);
-    while (stream_asset_list.good())
+    // Read the configuration file exactly once
+    if (!read_file(path, entries, book_lines))
     {
-        std::string substring;
-        std::getline(stream_asset_list, substring, ',');
-        assets_names.emplace_back(substring);
+        LOG.error("Configuration file cannot be read", {{"file", path}});
+        return false;
+    }
+    for (auto const &entry : overrides)
+    {
+        entries[entry.first] = entry.second;
+    }
+    for (auto const &entry : entries)
+    {
+        if (std::find(keys.begin(), keys.end(), entry.first) == keys.end())
+        {
+            LOG.warning("Configuration parameter is unknown", {{"parameter", entry.first}});
+        }
     }
 
-    // Set-up list of quantities of portfolio assets
-    std::stringstream stream_asset_quantities(asset_quants);
-    while (stream_asset_quantities.good())
+    // Every parameter is required - all invalid parameters are reported before giving up
+    bool valid(true);
+    for (auto const &parameter : schema)
     {
-        std::string substring;
-        std::getline(stream_asset_quantities, substring, ',');
-        asset_quantities.emplace_back(std::stod(substring));
+        auto entry(entries.find(parameter.key));
+        if (entry == entries.end())
+        {
+            LOG.error("Configuration parameter is missing", {{"parameter", parameter.key}});
+            valid = false;
+        }
+        else if (!set_parameter(parameter, entry->second))
+        {
+            if (parameter.choices)
+            {
+                LOG.error("Configuration parameter is invalid", {{"parameter", parameter.key}, {"value", entry->second}, {"allowed", vec2str(*parameter.choices)}});
+            }
+            else
+            {
+                LOG.error("Configuration parameter is invalid", {{"parameter", parameter.key}, {"value", entry->second}, {"minimum", parameter.minimum}, {"maximum", parameter.maximum}});
+            }
+            valid = false;
+        }
+        else
+        {
+            LOG.debug("Configuration parameter set", {{"parameter", parameter.key}, {"value", entry->second}});
+        }
     }
 
-    // Set-up starttime for polling OHLC data from Kraken API
-    std::stringstream stream_starttime(inputtime);
-    std::vector<int> utc;
-    while (stream_starttime.good())
+    // Bar length in minutes is handed to the API as text, but must be a positive number
+    double minutes(0.0);
+    if (!set_parameter(Parameter{"INTERVAL", &minutes, 1.0, unbounded}, interval))
     {
-        std::string substring;
-        std::getline(stream_starttime, substring, ',');
-        utc.emplace_back(std::stoi(substring));
+        LOG.error("Configuration parameter is invalid", {{"parameter", "INTERVAL"}, {"value", interval}});
+        valid = false;
     }
 
-    // From integer vector via a long unixtime to final string representation
-    starttime = std::to_string(get_unix_time(utc[0], utc[1], utc[2], utc[3], utc[4], utc[5]));
-    std::cout << "Configuration constructor executed." << std::endl;
+    // Formats of the sinks are a comma separated list - every element must be known unless no sink is written
+    if (sink_format != no_file)
+    {
+        for (auto const &format : str2vec(sink_format))
+        {
+            if (std::find(sink_formats.begin(), sink_formats.end(), format) == sink_formats.end())
+            {
+                LOG.error("Configuration parameter is invalid", {{"parameter", "SINK_FORMAT"}, {"value", format}, {"allowed", vec2str(sink_formats)}});
+                valid = false;
+            }
+        }
+    }
+
+    // Set-up starttime for polling OHLC data from Kraken API - from integer vector via a long unixtime to final string representation
+    std::vector<double> utc;
+    if (!read_numbers(inputtime, utc) || utc.size() != 6)
+    {
+        LOG.error("Configuration parameter is invalid", {{"parameter", "STARTTIME"}, {"value", inputtime}});
+        valid = false;
+    }
+    else
+    {
+        starttime = std::to_string(get_unix_time(static_cast<int>(utc[0]), static_cast<int>(utc[1]), static_cast<int>(utc[2]),
+                                                 static_cast<int>(utc[3]), static_cast<int>(utc[4]), static_cast<int>(utc[5])));
+    }
+
+    // Set-up list of names of all available assets
+    available_names = str2vec(available_tickers);
+
+    // First snapshot of the changeable parameters
+    auto initial(std::make_unique<Settings>());
+    valid = read_settings(entries, *initial) && valid;
+
+    // Set-up client books - without BOOK lines the single portfolio of ASSET_LIST is the only book
+    books.clear();
+    for (auto const &line : book_lines)
+    {
+        BookConfig book;
+        if (!read_book(line, book))
+        {
+            LOG.error("Configuration book is invalid", {{"line", line}});
+            valid = false;
+            continue;
+        }
+        books.emplace_back(book);
+    }
+    if (books.empty())
+    {
+        books.emplace_back(BookConfig{default_book, strategy, riskfree_quantity, initial->assets_names, initial->asset_quantities});
+    }
+
+    latest.store(initial.get(), std::memory_order_release);
+    versions.push_back(std::move(initial));
+
+    LOG.info("Configuration load() executed", {{"file", path}, {"overrides", overrides.size()}, {"books", books.size()}, {"valid", valid ? "yes" : "no"}});
+    return valid;
 }
 
-Configuration::~Configuration() noexcept
+auto Configuration::reload() noexcept -> bool
 {
-    std::cout << "Configuration destructor executed." << std::endl;
+    std::map<std::string, std::string> file;
+    std::vector<std::string> lines;
+    if (!read_file(path, file, lines))
+    {
+        LOG.warning("Configuration file cannot be read - keeping current parameters", {{"file", path}});
+        return false;
+    }
+    for (auto const &entry : overrides)
+    {
+        file[entry.first] = entry.second;
+    }
+
+    auto next(std::make_unique<Settings>());
+    if (!read_settings(file, *next))
+    {
+        LOG.warning("Configuration reload rejected - keeping current parameters", {{"version", settings().version}});
+        return false;
+    }
+
+    // Parameters fixed at startup are only reported
+    static const std::vector<std::string> changeable{"WEIGHT_DIFF", "PAUSE_PROG", "ASSET_LIST", "ASSET_QUANTITIES"};
+    for (auto const &entry : file)
+    {
+        auto previous(entries.find(entry.first));
+        if (std::find(changeable.begin(), changeable.end(), entry.first) == changeable.end() && (previous == entries.end() || previous->second != entry.second))
+        {
+            LOG.warning("Configuration parameter changed - takes effect after restart", {{"parameter", entry.first}});
+        }
+    }
+    if (lines != book_lines)
+    {
+        LOG.warning("Configuration books changed - take effect after restart");
+    }
+    if (books.front().name != default_book && (file["ASSET_LIST"] != entries["ASSET_LIST"] || file["ASSET_QUANTITIES"] != entries["ASSET_QUANTITIES"]))
+    {
+        LOG.warning("Configuration ASSET_LIST only applies without BOOK lines");
+    }
+    for (auto const &key : changeable)
+    {
+        entries[key] = file[key];
+    }
+
+    // Readers switch to the new snapshot with their next read - the previous one stays valid for readers still holding it
+    const Settings &current(settings());
+    next->version = current.version + 1;
+    LOG.info("Configuration reload() executed", {{"version", next->version}, {"weight_diff", next->weight_diff}, {"pause_program", next->pause_program}, {"assets", next->assets_names.size()}});
+    latest.store(next.get(), std::memory_order_release);
+    versions.push_back(std::move(next));
+    return true;
 }
 
-void Configuration::read_parameter(std::string &data, const std::string &parameter) noexcept
+auto Configuration::read_settings(const std::map<std::string, std::string> &file, Settings &result) const noexcept -> bool
 {
-    std::string line, key, value;
-    std::ifstream stream(Configuration::configfile);
+    std::string asset_list, asset_quants;
+    const std::vector<Parameter> schema{{"WEIGHT_DIFF", &result.weight_diff, 0.0, 1.0},
+                                        {"PAUSE_PROG", &result.pause_program, 1.0, 86400.0},
+                                        {"ASSET_LIST", &asset_list, 0.0, 0.0},
+                                        {"ASSET_QUANTITIES", &asset_quants, 0.0, 0.0}};
 
-    if (stream.is_open())
+    bool valid(true);
+    for (auto const &parameter : schema)
     {
-        while (std::getline(stream, line))
+        auto entry(file.find(parameter.key));
+        if (entry == file.end())
         {
-            std::istringstream linestream(line);
-            while (linestream >> key >> value)
+            LOG.error("Configuration parameter is missing", {{"parameter", parameter.key}});
+            valid = false;
+        }
+        else if (!set_parameter(parameter, entry->second))
+        {
+            if (parameter.choices)
             {
-                if (key == parameter)
-                {
-                    data = value;
-                }
+                LOG.error("Configuration parameter is invalid", {{"parameter", parameter.key}, {"value", entry->second}, {"allowed", vec2str(*parameter.choices)}});
             }
+            else
+            {
+                LOG.error("Configuration parameter is invalid", {{"parameter", parameter.key}, {"value", entry->second}, {"minimum", parameter.minimum}, {"maximum", parameter.maximum}});
+            }
+            valid = false;
         }
     }
-    stream.close();
-    std::cout << "read_parameter executed for parameter: " << parameter << std::endl;
+
+    // Set-up list of names and quantities of portfolio assets - trade the entire universe of available assets if requested
+    result.assets_names = str2vec(asset_list == all_available ? available_tickers : asset_list);
+    if (valid && !read_numbers(asset_quants, result.asset_quantities))
+    {
+        LOG.error("Configuration parameter is invalid", {{"parameter", "ASSET_QUANTITIES"}, {"value", asset_quants}});
+        valid = false;
+    }
+    // Assets without given quantity start with zero holdings
+    result.asset_quantities.resize(result.assets_names.size(), 0.0);
+
+    return valid;
 }
 
-void Configuration::read_parameter(double &data, const std::string &parameter) noexcept
+auto Configuration::read_file(const std::string &file, std::map<std::string, std::string> &found, std::vector<std::string> &lines) noexcept -> bool
 {
-    std::string convert;
-    read_parameter(convert, parameter);
-    data = std::stod(convert);
+    std::ifstream stream(file);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+
+    std::string line, key, value;
+    while (std::getline(stream, line))
+    {
+        std::istringstream linestream(line);
+        if (!(linestream >> key))
+        {
+            continue;
+        }
+        if (key == "BOOK")
+        {
+            lines.emplace_back(line);
+        }
+        else if (linestream >> value)
+        {
+            found[key] = value;
+        }
+    }
+    return true;
 }
 
-void Configuration::read_parameter(long &data, const std::string &parameter) noexcept
+auto Configuration::set_parameter(const Parameter &parameter, const std::string &value) noexcept -> bool
 {
-    std::string convert;
-    read_parameter(convert, parameter);
-    data = std::stol(convert);
+    const char *first(value.data()), *last(value.data() + value.size());
+    return std::visit(
+        [&](auto target) {
+            using Type = std::remove_pointer_t<decltype(target)>;
+            if constexpr (std::is_same_v<Type, std::string>)
+            {
+                *target = value;
+                return !value.empty() && (!parameter.choices || std::find(parameter.choices->begin(), parameter.choices->end(), value) != parameter.choices->end());
+            }
+            else
+            {
+                // Whole value must be one number - no partial conversion as with std::stod
+                Type number{};
+                auto [end, error] = std::from_chars(first, last, number);
+                if (error != std::errc() || end != last || static_cast<double>(number) < parameter.minimum || static_cast<double>(number) > parameter.maximum)
+                {
+                    return false;
+                }
+                *target = number;
+                return true;
+            }
+        },
+        parameter.target);
+}
+
+auto Configuration::read_numbers(const std::string &list, std::vector<double> &numbers) noexcept -> bool
+{
+    numbers.clear();
+    for (auto const &element : str2vec(list))
+    {
+        double number(0.0);
+        auto [end, error] = std::from_chars(element.data(), element.data() + element.size(), number);
+        if (error != std::errc() || end != element.data() + element.size())
+        {
+            return false;
+        }
+        numbers.emplace_back(number);
+    }
+    return true;
+}
+
+auto Configuration::read_book(const std::string &line, BookConfig &book) const noexcept -> bool
+{
+    std::istringstream linestream(line);
+    std::string key, quantity, names, quantities;
+    if (!(linestream >> key >> book.name >> book.strategy >> quantity >> names >> quantities) ||
+        std::find(strategies.begin(), strategies.end(), book.strategy) == strategies.end())
+    {
+        return false;
+    }
+
+    std::vector<double> riskfree;
+    if (!read_numbers(quantity, riskfree) || riskfree.size() != 1 || riskfree[0] < 0.0 || !read_numbers(quantities, book.asset_quantities))
+    {
+        return false;
+    }
+    book.riskfree_quantity = riskfree[0];
+    // Trade the entire universe of available assets if requested
+    book.assets_names = str2vec(names == all_available ? available_tickers : names);
+    book.asset_quantities.resize(book.assets_names.size(), 0.0);
+    return true;
 }
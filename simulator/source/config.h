@@ -19,26 +19,65 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include "logger.h"
 #include "utils.h"
 
 // This file contains program configuration calss
 
+// Struct for configuration of one client book (portfolio with own assets, quantities and strategy)
+struct BookConfig
+{
+    std::string name;
+    std::string strategy;
+    double riskfree_quantity{0.0};
+    std::vector<std::string> assets_names;
+    std::vector<double> asset_quantities;
+};
+
+// Struct for the parameters that can change while the program runs - published as immutable snapshots
+struct Settings
+{
+    // Number of the snapshot - increases with every accepted reload
+    long version{0};
+    double weight_diff{0.0};
+    long pause_program{1};
+    // Portfolio of the book built from ASSET_LIST and ASSET_QUANTITIES
+    std::vector<std::string> assets_names;
+    std::vector<double> asset_quantities;
+};
+
 // Class for configuration of entire program
 class Configuration
 {
 public:
-    // Path to configuration file
+    // Default path to configuration file - replaced by command line --config=<path> or environment ACCPO_CONFIG
     static constexpr char configfile[]{"../input/config.txt"};
 
-    // Variables controlling executino of program - Read and set during startup
+    // Variables controlling executino of program - Set by "load" at the start of main
     // Names correspond to entires in the configuration file
-    std::string apikey, seckey, asset_list, starttime, interval;
-    double riskfree_quantity, trade_fee, weight_diff;
-    long pause_api, pause_program;
+    // WEIGHT_DIFF, PAUSE_PROG, ASSET_LIST and ASSET_QUANTITIES can change while running - read them from "settings"
+    std::string apikey, seckey, available_tickers, starttime, interval, strategy, mc_method, tick_file, sink_format, sink_path;
+    double riskfree_quantity, trade_fee, hrp_tolerance;
+    long pause_api, bar_delay, hrp_lookback, walk_train, walk_test, mc_paths, mc_length, mc_block, sink_rotate;
 
     // Variables controlling executino of program - Read and set during startup
-    std::vector<std::string> assets_names;
-    std::vector<double> asset_quantities;
+    std::vector<std::string> available_names;
+
+    // Client books hosted by the program - from BOOK lines, otherwise one book from ASSET_LIST and ASSET_QUANTITIES
+    std::vector<BookConfig> books;
+    // Name of the book built from ASSET_LIST - only present without BOOK lines
+    const std::string default_book{"MAIN"};
+
+    // Keyword for TICK_FILE to neither record nor replay ticker snapshots and for SINK_FORMAT to write no records
+    const std::string no_file{"NONE"};
+
+    // Allowed values of STRATEGY (also for the strategy of BOOK lines), MC_METHOD and the elements of SINK_FORMAT
+    const std::vector<std::string> strategies{"deinvest", "equal", "hrp"};
+    const std::vector<std::string> mc_methods{"bootstrap", "gbm"};
+    const std::vector<std::string> sink_formats{"csv", "jsonl", "binary"};
+
+    // Keyword for ASSET_LIST to trade the entire universe of AVAILABLE_TICKERS
+    const std::string all_available{"AVAILABLE_TICKERS"};
 
     // Mapping of current (inside asset structure) portfolios to indicies
     std::map<size_t, std::string> idx2str = {std::make_pair(0, "INITIAL"),
@@ -53,10 +92,7 @@ public:
     static constexpr size_t BAL{1}; // Position of balanced current
     static constexpr size_t LAT{2}; // Position of latest current
 
-    // Flag to indicate key-press
-    std::atomic<bool> keyPress{false};
-
-    // Constructor reading configfile and setting configuration parameters
+    // Constructor - parameters are set by "load" only, nothing is read during static initialization
     explicit Configuration() noexcept;
 
     // Dummies to comply with the Rule of Five
@@ -68,11 +104,55 @@ public:
     // Destructor
     ~Configuration() noexcept;
 
+    // Read the configuration file in one pass and apply overrides - call once at the start of main
+    // Environment ACCPO_<KEY>=<value> overrides the file, command line --<KEY>=<value> overrides both
+    // Returns false if a parameter is missing, not a number or out of its valid range
+    [[nodiscard]] auto load(int argc, char *argv[]) noexcept -> bool;
+
+    // Read the configuration file again and publish its changeable parameters as a new snapshot
+    // Overrides given at startup still apply, changes of other parameters are reported and wait for a restart
+    // Returns false and keeps the current snapshot if a changeable parameter is invalid
+    [[nodiscard]] auto reload() noexcept -> bool;
+
+    // Read out the latest snapshot of the changeable parameters - never locks, reference stays valid until program end
+    [[nodiscard]] auto settings() const noexcept -> const Settings & { return *latest.load(std::memory_order_acquire); }
+    // Read out path of the configuration file in use
+    [[nodiscard]] auto get_path() const noexcept -> const std::string & { return path; }
+
 private:
-    // Read and return a single parameter from the configuration file, either string or double
-    static void read_parameter(std::string &data, const std::string &parameter) noexcept;
-    void read_parameter(double &data, const std::string &parameter) noexcept;
-    void read_parameter(long &data, const std::string &parameter) noexcept;
+    // Configuration file in use and overrides from environment and command line
+    std::string path;
+    std::map<std::string, std::string> overrides;
+    // Entries and BOOK lines of the last accepted read of the file - used to report changes needing a restart
+    std::map<std::string, std::string> entries;
+    std::vector<std::string> book_lines;
+
+    // Every snapshot ever published stays alive until the program ends - readers hold plain references
+    // Reloads are rare and snapshots small, so nothing is ever reclaimed
+    std::vector<std::unique_ptr<const Settings>> versions;
+    const Settings defaults{};
+    std::atomic<const Settings *> latest{&defaults};
+
+    // Struct for one entry of the typed schema - numbers must lie within [minimum, maximum], text must be one of "choices" if given
+    struct Parameter
+    {
+        const char *key;
+        std::variant<std::string *, double *, long *> target;
+        double minimum;
+        double maximum;
+        const std::vector<std::string> *choices{nullptr};
+    };
+
+    // Convert the changeable parameters of "file" into "result" - returns false if one of them is invalid
+    auto read_settings(const std::map<std::string, std::string> &file, Settings &result) const noexcept -> bool;
+    // Read all lines of the configuration file - "BOOK" lines are kept in order, of other keys the last one counts
+    static auto read_file(const std::string &file, std::map<std::string, std::string> &found, std::vector<std::string> &lines) noexcept -> bool;
+    // Convert "value" into the type of "parameter" and check its range or choices - returns false if invalid
+    static auto set_parameter(const Parameter &parameter, const std::string &value) noexcept -> bool;
+    // Convert a comma separated list of numbers - returns false on the first invalid number
+    static auto read_numbers(const std::string &list, std::vector<double> &numbers) noexcept -> bool;
+    // Set up one book from a line of format "BOOK name strategy riskfree_quantity asset_list asset_quantities"
+    auto read_book(const std::string &line, BookConfig &book) const noexcept -> bool;
 };
 
 // Initialize a program wide set of the configuration parameters
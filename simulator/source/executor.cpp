@@ -0,0 +1,208 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "executor.h"
+
+#include <csignal>
+#include <pthread.h>
+
+// Index of the worker running on this thread - none for threads outside the pool
+static thread_local size_t worker_index(std::numeric_limits<size_t>::max());
+
+Executor::Executor() noexcept
+{
+    size_t workers(std::max(std::thread::hardware_concurrency(), 1U));
+    for (size_t worker(0); worker < workers; worker++)
+    {
+        queues.push_back(std::make_unique<Queues>());
+    }
+
+    // Workers start before main - they must not receive the signals handled by the scheduler
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    for (size_t worker(0); worker < workers; worker++)
+    {
+        threads.emplace_back(&Executor::run, this, worker);
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+    LOG.info("Executor constructor executed", {{"workers", workers}});
+}
+
+Executor::~Executor() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        running.store(false);
+    }
+    sleep.notify_all();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    LOG.text(output().str());
+    LOG.info("Executor destructor executed");
+}
+
+void Executor::fork_join(const Priority &priority, const size_t &tasks, const std::function<void()> &function) noexcept
+{
+    std::atomic<size_t> remaining{tasks};
+    for (size_t task(0); task < tasks; task++)
+    {
+        push(priority, [this, &function, &remaining]() {
+            function();
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                // Last task wakes the joining thread - taking the lock orders the decrement before its check
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                }
+                sleep.notify_all();
+            }
+        });
+    }
+
+    // Run pending tasks meanwhile and sleep while there are none - woken by new tasks or the last task finishing
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (help())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep.wait(lock, [this, &remaining]() { return remaining.load() == 0 || pending.load() > 0; });
+    }
+}
+
+auto Executor::output() const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+    static constexpr const char *names[]{"high", "normal", "low"};
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Executor with " << std::to_string(threads.size()) << " workers - scheduling latency per priority" << std::endl;
+    result << "Priority:      Tasks   Mean (ms)    Max (ms)" << std::endl;
+    for (size_t level(0); level < priorities; level++)
+    {
+        size_t tasks(latency[level].tasks.load());
+        double mean(tasks > 0 ? static_cast<double>(latency[level].total.load()) / static_cast<double>(tasks) / 1.0e6 : 0.0);
+        double maximum(static_cast<double>(latency[level].maximum.load()) / 1.0e6);
+        result << std::left << std::setw(8) << names[level] << std::right << std::setw(12) << std::to_string(tasks);
+        result << num2str(mean) << num2str(maximum) << std::endl;
+    }
+    result << "Tasks waiting: " << std::to_string(pending.load()) << std::endl;
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
+
+void Executor::push(const Priority &priority, std::function<void()> work) noexcept
+{
+    size_t index(worker_index < queues.size() ? worker_index : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks[static_cast<size_t>(priority)].push_back(Task{std::move(work), std::chrono::steady_clock::now(), priority});
+    }
+    pending.fetch_add(1);
+
+    // Taking the lock orders the increment before the check of a worker about to sleep - no wakeup is lost
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep.notify_one();
+}
+
+auto Executor::pop(Task &task) noexcept -> bool
+{
+    size_t self(worker_index < queues.size() ? worker_index : 0);
+    for (size_t level(0); level < priorities; level++)
+    {
+        for (size_t offset(0); offset < queues.size(); offset++)
+        {
+            size_t index((self + offset) % queues.size());
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            std::deque<Task> &tasks(queues[index]->tasks[level]);
+            if (tasks.empty())
+            {
+                continue;
+            }
+            // Own newest task is still hot in the cache - stolen tasks are the oldest ones
+            bool own(index == worker_index);
+            task = std::move(own ? tasks.back() : tasks.front());
+            if (own)
+            {
+                tasks.pop_back();
+            }
+            else
+            {
+                tasks.pop_front();
+            }
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+auto Executor::help() noexcept -> bool
+{
+    Task task;
+    if (!pop(task))
+    {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void Executor::execute(Task &task) noexcept
+{
+    long long waited(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - task.queued).count());
+    Latency &record(latency[static_cast<size_t>(task.priority)]);
+    record.tasks.fetch_add(1, std::memory_order_relaxed);
+    record.total.fetch_add(waited, std::memory_order_relaxed);
+    long long maximum(record.maximum.load(std::memory_order_relaxed));
+    while (waited > maximum && !record.maximum.compare_exchange_weak(maximum, waited, std::memory_order_relaxed))
+    {
+    }
+
+    task.work();
+}
+
+void Executor::run(const size_t &index) noexcept
+{
+    worker_index = index;
+    while (true)
+    {
+        if (help())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep.wait(lock, [this]() { return pending.load() > 0 || !running.load(); });
+        if (!running.load() && pending.load() == 0)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "logger.h"
+#include "utils.h"
+
+// Priority of a task - workers always run pending tasks of higher priority first
+enum class Priority : unsigned char
+{
+    High,   // Work on the critical path of the polling loop (optimization of books)
+    Normal, // Work waited for by a caller (report formatting)
+    Low     // Throughput work (backtest sweeps and Monte Carlo paths)
+};
+
+// Class for one pool of worker threads shared by the entire program - sized to the machine
+// Every worker owns one queue per priority: it runs its own newest task first and steals the oldest tasks of others
+// Threads waiting for tasks help executing pending tasks, so waiting inside a task never blocks a worker
+class Executor
+{
+public:
+    // Constructor - starts one worker per hardware thread
+    explicit Executor() noexcept;
+    // Destructor - runs all pending tasks and stops the workers
+    ~Executor() noexcept;
+    // Dummies to comply with the Rule of Five
+    Executor(const Executor &source) = delete;
+    Executor(Executor &&source) = delete;
+    auto operator=(const Executor &source) -> Executor & = delete;
+    auto operator=(Executor &&source) -> Executor & = delete;
+
+    // Run "function" as task - the future holds its result
+    template <typename F>
+    [[nodiscard]] auto submit(const Priority &priority, F &&function) noexcept -> std::future<std::invoke_result_t<F>>
+    {
+        auto task(std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(function)));
+        auto result(task->get_future());
+        push(priority, [task]() { (*task)(); });
+        return result;
+    }
+
+    // Wait for "future" and return its result - executes pending tasks meanwhile
+    template <typename T>
+    [[nodiscard]] auto wait(std::future<T> &future) noexcept -> T
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!help())
+            {
+                future.wait_for(std::chrono::microseconds(100));
+            }
+        }
+        return future.get();
+    }
+
+    // Run "function" as "tasks" tasks and return once all finished - the calling thread executes tasks meanwhile
+    // Each task typically claims chunks of shared work through an atomic counter until none is left
+    void fork_join(const Priority &priority, const size_t &tasks, const std::function<void()> &function) noexcept;
+
+    // Read out number of worker threads
+    [[nodiscard]] auto number_workers() const noexcept -> size_t { return threads.size(); }
+
+    // Prints to the console the number of tasks and the scheduling latency (queued until started) per priority
+    [[nodiscard]] auto output() const noexcept -> const std::stringstream;
+
+private:
+    static constexpr size_t priorities{3};
+
+    // One queued task and the time it was queued at
+    struct Task
+    {
+        std::function<void()> work;
+        std::chrono::steady_clock::time_point queued;
+        Priority priority{Priority::Normal};
+    };
+
+    // Queues of one worker - the owner works at the back, thieves take from the front
+    struct Queues
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks[priorities];
+    };
+
+    // Scheduling latency of all tasks of one priority
+    struct Latency
+    {
+        std::atomic<size_t> tasks{0};
+        std::atomic<long long> total{0};
+        std::atomic<long long> maximum{0};
+    };
+
+    std::vector<std::unique_ptr<Queues>> queues;
+    std::vector<std::thread> threads;
+    Latency latency[priorities];
+
+    // Number of queued tasks - workers sleep while zero
+    std::atomic<size_t> pending{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep;
+    std::atomic<bool> running{true};
+    // Queue of the next task submitted from outside the pool
+    std::atomic<size_t> next_queue{0};
+
+    // Queue a task - into the queue of the calling worker or round robin from outside the pool
+    void push(const Priority &priority, std::function<void()> work) noexcept;
+    // Take the task of highest priority - own queue first, then steal from the other workers
+    [[nodiscard]] auto pop(Task &task) noexcept -> bool;
+    // Execute one pending task if there is any - returns false if there was none
+    auto help() noexcept -> bool;
+    // Execute "task" and record its scheduling latency
+    void execute(Task &task) noexcept;
+    // Loop of worker "index"
+    void run(const size_t &index) noexcept;
+};
+
+// Initialize a program wide pool of worker threads - after the logger so that it is destroyed before it
+inline Executor POOL;
+
+#endif
@@ -18,105 +18,156 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "kraken.h"
 
-Kraken::Kraken(const std::string &apikey, const std::string &seckey) noexcept
+Kraken::Kraken(const std::string &apikey, const std::string &seckey, Scheduler &scheduler) noexcept
+    : scheduler(scheduler), next_call(std::chrono::steady_clock::now())
 {
     kraken_init(&kr_api, apikey.c_str(), seckey.c_str());
-    std::cout << "Kraken constructor executed." << std::endl;
+    worker = std::thread(&Kraken::run, this);
+    LOG.info("Kraken constructor executed");
 }
 
 Kraken::~Kraken() noexcept
 {
-    kraken_clean(&kr_api);
-    std::cout << "Kraken destructor executed." << std::endl;
-}
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    ready.notify_one();
+    worker.join();
 
-void Kraken::pause_api(long &seconds) const noexcept
-{
-    std::cout << "Kraken API is paused for: " << std::to_string(seconds) << " seconds." << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    kraken_clean(&kr_api);
+    LOG.info("Kraken destructor executed");
 }
 
-void Kraken::get_server_time(long &data) noexcept
+auto Kraken::server_time(long &data) noexcept -> std::future<bool>
 {
-    kr_api->pub_func->get_server_time(&kr_api);
-    store_and_free();
+    return submit([this, &data]() {
+        kr_api->pub_func->get_server_time(&kr_api);
+        json result(store_and_free());
 
-    data = std::stol(result_api["result"]["unixtime"].dump());
+        data = std::stol(result["result"]["unixtime"].dump());
+    });
 }
 
-void Kraken::get_ohlc_data(Historic &data, const std::string &ticker, const std::string &since, const std::string &interval) noexcept
+auto Kraken::ohlc(Historic &data, const std::string &ticker, const std::string &since, const std::string &interval) noexcept -> std::future<bool>
 {
-    kraken_set_opt(&kr_api, "interval", interval.c_str());
-    kraken_set_opt(&kr_api, "since", since.c_str());
-
-    kr_api->pub_func->get_ohlc_data(&kr_api, ticker.c_str());
-    store_and_free();
+    return submit([this, &data, ticker, since, interval]() {
+        kraken_set_opt(&kr_api, "interval", interval.c_str());
+        kraken_set_opt(&kr_api, "since", since.c_str());
 
-    json ohlc(result_api["result"][ticker]);
+        kr_api->pub_func->get_ohlc_data(&kr_api, ticker.c_str());
+        json ohlc(store_and_free()["result"][ticker]);
 
-    for (auto slice : ohlc)
-    {
-        long extract_long = slice[0].get<long>();
-        data.time.emplace_back(extract_long);
+        for (auto slice : ohlc)
+        {
+            long extract_long = slice[0].get<long>();
+            data.time.emplace_back(extract_long);
 
-        auto extract_string = slice[1].get<std::string>();
-        data.open.emplace_back(std::stod(extract_string));
+            auto extract_string = slice[1].get<std::string>();
+            data.open.emplace_back(std::stod(extract_string));
 
-        extract_string = slice[2].get<std::string>();
-        data.high.emplace_back(std::stod(extract_string));
+            extract_string = slice[2].get<std::string>();
+            data.high.emplace_back(std::stod(extract_string));
 
-        extract_string = slice[3].get<std::string>();
-        data.low.emplace_back(std::stod(extract_string));
+            extract_string = slice[3].get<std::string>();
+            data.low.emplace_back(std::stod(extract_string));
 
-        extract_string = slice[4].get<std::string>();
-        data.close.emplace_back(std::stod(extract_string));
+            extract_string = slice[4].get<std::string>();
+            data.close.emplace_back(std::stod(extract_string));
 
-        extract_string = slice[5].get<std::string>();
-        data.vwap.emplace_back(std::stod(extract_string));
+            extract_string = slice[5].get<std::string>();
+            data.vwap.emplace_back(std::stod(extract_string));
 
-        extract_string = slice[6].get<std::string>();
-        data.volume.emplace_back(std::stod(extract_string));
+            extract_string = slice[6].get<std::string>();
+            data.volume.emplace_back(std::stod(extract_string));
 
-        extract_long = slice[7].get<long>();
-        data.count.emplace_back(extract_long);
-    }
+            extract_long = slice[7].get<long>();
+            data.count.emplace_back(extract_long);
+        }
 
-    data.quantity = std::vector<double>(data.size(), 0.0);
+        data.quantity = std::vector<double>(data.size(), 0.0);
 
-    std::cout << "Kraken get_ohlc_data() executed for: " << ticker << std::endl;
+        LOG.debug("Kraken ohlc() executed", {{"ticker", ticker}});
+    });
 }
 
-void Kraken::fetch_all_tickers(const std::string &ticker_list) noexcept
+auto Kraken::ticker(std::map<std::string, Current> &data, const std::string &ticker_list) noexcept -> std::future<bool>
 {
-    kr_api->pub_func->get_ticker_info(&kr_api, ticker_list.c_str());
-    store_and_free();
-
-    std::cout << "Kraken fetch_all_tickers() executed." << std::endl;
+    return submit([this, &data, ticker_list]() {
+        kr_api->pub_func->get_ticker_info(&kr_api, ticker_list.c_str());
+        json result(store_and_free()["result"]);
+
+        for (auto const &ticker : str2vec(ticker_list))
+        {
+            json extract(result[ticker]);
+
+            auto ask(extract["a"][0].get<std::string>());
+            auto bid(extract["b"][0].get<std::string>());
+            auto quote(extract["c"][0].get<std::string>());
+
+            Current &current(data[ticker]);
+            current.ask = std::stod(ask);
+            current.bid = std::stod(bid);
+            current.price = std::stod(quote);
+            get_system_time(current.time);
+        }
+
+        LOG.debug("Kraken ticker() executed");
+    });
 }
 
-void Kraken::get_ticker_data(Current &data, const std::string &ticker) noexcept
+auto Kraken::submit(std::function<void()> call) noexcept -> std::future<bool>
 {
-    json extract(result_api["result"][ticker]);
-
-    auto ask(extract["a"][0].get<std::string>());
-    auto bid(extract["b"][0].get<std::string>());
-    auto quote(extract["c"][0].get<std::string>());
-
-    data.ask = std::stod(ask);
-    data.bid = std::stod(bid);
-    data.price = std::stod(quote);
-    get_system_time(data.time);
+    Request request{std::move(call), std::promise<bool>()};
+    std::future<bool> result(request.done.get_future());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(std::move(request));
+    }
+    ready.notify_one();
+    return result;
+}
 
-    std::cout << "Kraken get_ticker_data() executed for: " << ticker << std::endl;
+void Kraken::run() noexcept
+{
+    while (true)
+    {
+        Request request;
+        bool cancelled;
+        size_t queued;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return !running || !requests.empty(); });
+            if (requests.empty())
+            {
+                break;
+            }
+            request = std::move(requests.front());
+            requests.pop_front();
+            cancelled = !running;
+            queued = requests.size();
+        }
+
+        // Kraken exchange limits the number of calls to the API per time interval
+        // Pause API for some time to prevent being blocked out - requests queued on shutdown are answered right away
+        LOG.debug("Kraken API is paused", {{"queued", queued}});
+        if (cancelled || !scheduler.wait_until(next_call))
+        {
+            request.done.set_value(false);
+            continue;
+        }
+
+        request.call();
+        next_call = std::chrono::steady_clock::now() + std::chrono::seconds(CF.pause_api);
+        request.done.set_value(true);
+    }
 }
 
-void Kraken::store_and_free() noexcept
+auto Kraken::store_and_free() noexcept -> json
 {
-    result_buffer = std::string(kr_api->s_result);
-    result_api = json::parse(result_buffer);
-    //output_result_buffer();
+    json result(json::parse(kr_api->s_result));
 
     free(kr_api->s_result);
     kr_api->s_result = nullptr;
-    //std::cout << "Kraken store_and_free() executed." << std::endl;
+    return result;
 }
@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define KRAKEN_H
 
 #include "asset.h"
+#include "scheduler.h"
 #include "utils.h"
 
 // Using API to Kraken exchange written for C11 language
@@ -32,12 +33,14 @@ extern "C"
 using json = nlohmann::json;
 
 // Wrapper for communication with Kraken exchange
+// All calls run on one request thread owning the API connection - callers queue any number of requests and
+// receive a future each, the request thread works through them spaced by PAUSE_API to stay within the rate limit
 class Kraken
 {
 public:
-    // Constructor - takes two API keys
-    Kraken(const std::string &apikey, const std::string &seckey) noexcept;
-    // Destructor - clean up
+    // Constructor - takes two API keys and scheduler for pausing the API
+    Kraken(const std::string &apikey, const std::string &seckey, Scheduler &scheduler) noexcept;
+    // Destructor - cancels requests not yet sent and stops the request thread
     ~Kraken() noexcept;
     // Dummies to comply with Rule of Five
     Kraken(const Kraken &source) = delete;
@@ -45,32 +48,46 @@ public:
     auto operator=(const Kraken &source) -> Kraken & = delete;
     auto operator=(Kraken &&source) -> Kraken & = delete;
 
-    // Kraken exchange number of limits calls to API per time interval
-    // Pause API for some time to prevent being blocked out by API
-    void pause_api(long &seconds) const noexcept;
-
+    // Queue requests - "data" must outlive the returned future, which holds false if cancelled by shutdown
     // Get server time - Useful for comparing with local time
-    void get_server_time(long &data) noexcept;
-
-    // Get historic data OHLC for one ticker at a time from "start" time in spacing of "interval"
-    void get_ohlc_data(Historic &data, const std::string &ticker, const std::string &since, const std::string &interval) noexcept;
-
-    // Get latest price/ticker information for several tickers in list - store result in buffer
-    void fetch_all_tickers(const std::string &ticker_list) noexcept;
+    [[nodiscard]] auto server_time(long &data) noexcept -> std::future<bool>;
+    // Get historic data OHLC for one ticker at a time from "since" time in spacing of "interval"
+    [[nodiscard]] auto ohlc(Historic &data, const std::string &ticker, const std::string &since, const std::string &interval) noexcept -> std::future<bool>;
+    // Get latest price/ticker information for all tickers of comma separated list in one single call
+    [[nodiscard]] auto ticker(std::map<std::string, Current> &data, const std::string &ticker_list) noexcept -> std::future<bool>;
 
-    // From buffer extract one individual ticker information - execute "fetch_all_tickers" first
-    void get_ticker_data(Current &data, const std::string &ticker) noexcept;
+    // Synchronous wrappers - block until the request was answered, return false if cancelled by shutdown
+    [[nodiscard]] auto get_server_time(long &data) noexcept -> bool { return server_time(data).get(); }
+    [[nodiscard]] auto get_ohlc_data(Historic &data, const std::string &ticker, const std::string &since, const std::string &interval) noexcept -> bool { return ohlc(data, ticker, since, interval).get(); }
+    [[nodiscard]] auto get_ticker_data(std::map<std::string, Current> &data, const std::string &ticker_list) noexcept -> bool { return ticker(data, ticker_list).get(); }
 
 private:
-    // Pointer to API
+    // Struct for one queued call to the API and the promise answering it
+    struct Request
+    {
+        std::function<void()> call;
+        std::promise<bool> done;
+    };
+
+    // Pointer to API - only used by the request thread
     struct kraken_api *kr_api = nullptr;
-
-    // Buffer to store ersult from last API query
-    std::string result_buffer;
-    json result_api;
-
-    // Call after each API usage to store result and clean API
-    void store_and_free() noexcept;
+    Scheduler &scheduler;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Request> requests;
+    bool running{true};
+    // Earliest time of the next call to the API
+    std::chrono::steady_clock::time_point next_call;
+    std::thread worker;
+
+    // Queue one call to the API
+    [[nodiscard]] auto submit(std::function<void()> call) noexcept -> std::future<bool>;
+    // Request thread - one call at a time at the rate limit
+    void run() noexcept;
+
+    // Call after each API usage to parse result and clean API
+    [[nodiscard]] auto store_and_free() noexcept -> json;
 };
 
 #endif
@@ -0,0 +1,349 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "logger.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <pthread.h>
+#include <unistd.h>
+
+Logger::Logger() noexcept
+    : late(std::make_shared<Producer>()), steady_start(std::chrono::steady_clock::now()), system_start(std::chrono::system_clock::now())
+{
+    // Flusher thread starts before main - it must not receive the signals handled by the scheduler
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    flusher = std::thread(&Logger::run, this);
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+}
+
+Logger::~Logger() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        running.store(false);
+    }
+    wake.notify_one();
+    flusher.join();
+}
+
+auto Logger::local() noexcept -> Producer *
+{
+    // Plain pointer stays readable after the guard below was destroyed at exit of the thread
+    static thread_local Producer *buffer(nullptr);
+    static thread_local bool exited(false);
+
+    if (buffer == nullptr && !exited)
+    {
+        // Retires the buffer at exit of the thread - the flusher thread removes it once drained
+        struct Guard
+        {
+            ~Guard()
+            {
+                buffer->retired.store(true, std::memory_order_release);
+                buffer = nullptr;
+                exited = true;
+            }
+        };
+
+        auto producer(std::make_shared<Producer>());
+        {
+            std::lock_guard<std::mutex> lock(registry);
+            producers.push_back(producer);
+        }
+        buffer = producer.get();
+        thread_local Guard guard;
+    }
+    return buffer;
+}
+
+void Logger::log(const Level &level, const char *message, std::initializer_list<Field> fields) noexcept
+{
+    LogEntry entry;
+    entry.time = std::chrono::steady_clock::now().time_since_epoch().count();
+    entry.level = level;
+    entry.message = message;
+    for (auto const &field : fields)
+    {
+        if (entry.count == LogEntry::max_fields)
+        {
+            break;
+        }
+        entry.fields[entry.count++] = field;
+    }
+
+    Producer *producer(local());
+    if (producer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(registry);
+        producer = late.get();
+        if (!producer->queue.try_push(std::move(entry)))
+        {
+            producer->dropped++;
+            return;
+        }
+    }
+    else if (!producer->queue.try_push(std::move(entry)))
+    {
+        producer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    post();
+}
+
+void Logger::text(std::string block) noexcept
+{
+    LogEntry entry;
+    entry.time = std::chrono::steady_clock::now().time_since_epoch().count();
+    entry.block = std::move(block);
+
+    Producer *producer(local());
+    if (producer == nullptr)
+    {
+        push_waiting(*late, entry, &registry);
+    }
+    else
+    {
+        push_waiting(*producer, entry, nullptr);
+    }
+    post();
+}
+
+auto Logger::borrow_block() noexcept -> std::string
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!pool.empty())
+        {
+            std::string block(std::move(pool.back()));
+            pool.pop_back();
+            return block;
+        }
+    }
+
+    std::string block;
+    block.reserve(block_capacity);
+    return block;
+}
+
+void Logger::return_block(std::string block) noexcept
+{
+    // Blocks of other origin are too small to be worth keeping
+    if (block.capacity() < block_capacity)
+    {
+        return;
+    }
+    block.clear();
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    if (pool.size() < pooled)
+    {
+        pool.push_back(std::move(block));
+    }
+}
+
+void Logger::post() noexcept
+{
+    posted.fetch_add(1);
+    // Paired with the flusher setting "sleeping" before checking "posted" - one of both sees the other
+    if (sleeping.load())
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+        }
+        wake.notify_one();
+    }
+}
+
+void Logger::push_waiting(Producer &producer, LogEntry &entry, std::mutex *guard) noexcept
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock;
+            if (guard != nullptr)
+            {
+                lock = std::unique_lock<std::mutex>(*guard);
+            }
+            if (producer.queue.try_push(std::move(entry)))
+            {
+                return;
+            }
+        }
+
+        // Buffer is full, so the flusher thread is awake - it notifies after draining while a producer is blocked
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        blocked.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        space.wait(lock, [&producer]() { return !producer.queue.full(); });
+        blocked.fetch_sub(1);
+    }
+}
+
+void Logger::run() noexcept
+{
+    std::vector<LogEntry> batch;
+    std::string output;
+    LogEntry entry;
+
+    while (true)
+    {
+        // Stop flag and number of posted entries are read before draining so no entry logged meanwhile is lost
+        bool stopping(!running.load());
+        size_t seen(posted.load());
+        size_t dropped(0);
+        {
+            std::lock_guard<std::mutex> lock(registry);
+            for (auto producer(producers.begin()); producer != producers.end();)
+            {
+                // A retired buffer gets no more entries - read before draining it for the last time
+                bool retired((*producer)->retired.load(std::memory_order_acquire));
+                while ((*producer)->queue.try_pop(entry))
+                {
+                    batch.push_back(std::move(entry));
+                }
+                dropped += (*producer)->dropped.exchange(0, std::memory_order_relaxed);
+                producer = retired ? producers.erase(producer) : producer + 1;
+            }
+            while (late->queue.try_pop(entry))
+            {
+                batch.push_back(std::move(entry));
+            }
+            dropped += late->dropped.exchange(0);
+        }
+
+        // Paired with a producer announcing itself as blocked before checking for room - one of both sees the other
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (blocked.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+            }
+            space.notify_all();
+        }
+
+        // Entries of different threads are written in order of their time
+        std::stable_sort(batch.begin(), batch.end(), [](const LogEntry &first, const LogEntry &second) { return first.time < second.time; });
+        for (auto const &logged : batch)
+        {
+            format(logged, output);
+        }
+        if (dropped > 0)
+        {
+            LogEntry warning;
+            warning.time = std::chrono::steady_clock::now().time_since_epoch().count();
+            warning.level = Level::Warning;
+            warning.message = "Logger buffer full - entries dropped";
+            warning.fields[warning.count++] = Field("dropped", dropped);
+            format(warning, output);
+        }
+
+        for (size_t written(0); written < output.size();)
+        {
+            ssize_t result(::write(1, output.data() + written, output.size() - written));
+            if (result < 0 && errno != EINTR)
+            {
+                break;
+            }
+            written += result > 0 ? static_cast<size_t>(result) : 0;
+        }
+
+        // Written blocks go back to the pool of buffers
+        for (auto &logged : batch)
+        {
+            if (logged.message == nullptr)
+            {
+                return_block(std::move(logged.block));
+            }
+        }
+        batch.clear();
+        output.clear();
+
+        if (stopping)
+        {
+            break;
+        }
+
+        // Sleep until an entry is posted after the one drained last - or until stopped
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        sleeping.store(true);
+        wake.wait(lock, [this, &seen]() { return posted.load() != seen || !running.load(); });
+        sleeping.store(false);
+    }
+}
+
+void Logger::format(const LogEntry &entry, std::string &output) const noexcept
+{
+    if (entry.message == nullptr)
+    {
+        output += entry.block;
+        return;
+    }
+
+    static constexpr char levels[]{'D', 'I', 'W', 'E'};
+
+    // Wall clock time with microseconds from the steady time of the entry
+    auto steady(std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(entry.time)));
+    auto wall(system_start + std::chrono::duration_cast<std::chrono::system_clock::duration>(steady - steady_start));
+    time_t seconds(std::chrono::system_clock::to_time_t(wall));
+    auto micro(std::chrono::duration_cast<std::chrono::microseconds>(wall.time_since_epoch()).count() % 1000000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+
+    char stamp[64];
+    size_t length(std::strftime(stamp, sizeof(stamp), "%F - %T", &local));
+    std::snprintf(stamp + length, sizeof(stamp) - length, ".%06ld", static_cast<long>(micro));
+
+    output += levels[static_cast<size_t>(entry.level)];
+    output += ' ';
+    output += stamp;
+    output += ' ';
+    output += entry.message;
+
+    char value[64];
+    for (size_t field(0); field < entry.count; field++)
+    {
+        const Field &data(entry.fields[field]);
+        output += ' ';
+        output += data.key;
+        output += '=';
+        switch (data.kind)
+        {
+        case Field::Kind::Integer:
+            output.append(value, std::to_chars(value, value + sizeof(value), data.integer).ptr);
+            break;
+        case Field::Kind::Number:
+            output.append(value, std::to_chars(value, value + sizeof(value), data.number).ptr);
+            break;
+        case Field::Kind::Text:
+            if (data.overflow.empty())
+            {
+                output.append(data.text, data.length);
+            }
+            else
+            {
+                output += data.overflow;
+            }
+            break;
+        }
+    }
+    output += '\n';
+}
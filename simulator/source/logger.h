@@ -0,0 +1,186 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "queue.h"
+#include "utils.h"
+
+// Debug entries are only compiled in with ACCPO_DEBUG_LOG - otherwise every call of debug() is removed by the compiler
+#ifdef ACCPO_DEBUG_LOG
+inline constexpr bool debug_logged{true};
+#else
+inline constexpr bool debug_logged{false};
+#endif
+
+// Severity of a log entry
+enum class Level : unsigned char
+{
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+// One structured field "key=value" of a log entry - the value is kept in binary and formatted by the flusher thread
+// Keys must be string literals, text values are copied into the field - only values longer than the field allocate
+struct Field
+{
+    enum class Kind : unsigned char
+    {
+        Integer,
+        Number,
+        Text
+    };
+
+    Field() noexcept = default;
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    Field(const char *key, const T &value) noexcept : key(key), kind(Kind::Integer), integer(static_cast<long long>(value)) {}
+    template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    Field(const char *key, const T &value) noexcept : key(key), kind(Kind::Number), number(static_cast<double>(value)) {}
+    Field(const char *key, std::string_view value) noexcept : key(key), kind(Kind::Text)
+    {
+        if (value.size() > sizeof(text))
+        {
+            // Diagnostics such as paths and rejected values are kept whole
+            overflow.assign(value);
+            return;
+        }
+        length = static_cast<unsigned char>(value.size());
+        std::copy(value.begin(), value.end(), text);
+    }
+
+    const char *key{nullptr};
+    Kind kind{Kind::Integer};
+    unsigned char length{0};
+    long long integer{0};
+    double number{0.0};
+    char text[32]{};
+    // Text values longer than "text"
+    std::string overflow;
+};
+
+// One entry in the buffer of a logging thread - either a message with fields or a block of formatted output
+struct LogEntry
+{
+    static constexpr size_t max_fields{4};
+
+    long long time{0};
+    Level level{Level::Info};
+    unsigned char count{0};
+    const char *message{nullptr};
+    Field fields[max_fields];
+    // Block of output such as reports and tables - written as it is
+    std::string block;
+};
+
+// Class for asynchronous logging to the standard output
+// Every logging thread writes into its own lock-free buffer - no locks or system calls on the calling thread, allocations only for long text fields
+// A background thread collects the entries of all threads in order of time, formats them and writes them out
+class Logger
+{
+public:
+    // Constructor - starts the flusher thread
+    explicit Logger() noexcept;
+    // Destructor - writes out all remaining entries and stops the flusher thread
+    ~Logger() noexcept;
+    // Dummies to comply with the Rule of Five
+    Logger(const Logger &source) = delete;
+    Logger(Logger &&source) = delete;
+    auto operator=(const Logger &source) -> Logger & = delete;
+    auto operator=(Logger &&source) -> Logger & = delete;
+
+    // Log "message" (a string literal) with up to four structured fields - entries are dropped if the buffer is full
+    void debug(const char *message, std::initializer_list<Field> fields = {}) noexcept
+    {
+        if constexpr (debug_logged)
+        {
+            log(Level::Debug, message, fields);
+        }
+    }
+    void info(const char *message, std::initializer_list<Field> fields = {}) noexcept { log(Level::Info, message, fields); }
+    void warning(const char *message, std::initializer_list<Field> fields = {}) noexcept { log(Level::Warning, message, fields); }
+    void error(const char *message, std::initializer_list<Field> fields = {}) noexcept { log(Level::Error, message, fields); }
+
+    // Hand over a block of formatted output - never dropped, waits while the buffer of the thread is full
+    void text(std::string block) noexcept;
+
+    // Capacity of the buffers in the pool for blocks of output
+    static constexpr size_t block_capacity{1 << 16};
+    // Borrow an empty buffer of "block_capacity" characters - handed over with text() it returns to the pool once written out
+    // Allocates only while the pool has no buffer to reuse
+    [[nodiscard]] auto borrow_block() noexcept -> std::string;
+    // Return a borrowed buffer that is not handed over with text()
+    void return_block(std::string block) noexcept;
+
+private:
+    // Buffer of one logging thread - retired when the thread exits and removed once drained
+    struct Producer
+    {
+        SpscQueue<LogEntry> queue{1024};
+        std::atomic<bool> retired{false};
+        std::atomic<size_t> dropped{0};
+    };
+
+    // Buffer of the calling thread - registered on its first entry, nullptr once the thread is exiting
+    auto local() noexcept -> Producer *;
+    void log(const Level &level, const char *message, std::initializer_list<Field> fields) noexcept;
+
+    // Buffers of all threads - the mutex is only taken to register a thread and by the flusher thread
+    std::mutex registry;
+    std::vector<std::shared_ptr<Producer>> producers;
+    // Buffer for threads logging after their own buffer was retired (static destructors) - pushed under the registry mutex
+    std::shared_ptr<Producer> late;
+
+    // Steady time and system time at construction - converts times of entries into wall clock time
+    std::chrono::steady_clock::time_point steady_start;
+    std::chrono::system_clock::time_point system_start;
+
+    // Written blocks kept for reuse by borrow_block() - at most "pooled" buffers
+    static constexpr size_t pooled{8};
+    std::mutex pool_mutex;
+    std::vector<std::string> pool;
+
+    // Flusher thread sleeps while nothing was posted - a producer takes the lock only to wake it or to wait for room
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::condition_variable space;
+    std::atomic<size_t> posted{0};
+    std::atomic<bool> sleeping{false};
+    std::atomic<size_t> blocked{0};
+
+    std::atomic<bool> running{true};
+    std::thread flusher;
+
+    // Count an entry pushed into a buffer and wake the flusher thread if it sleeps
+    void post() noexcept;
+    // Push "entry" into buffer of "producer" - waits for room while it is full, "guard" is held only while pushing
+    void push_waiting(Producer &producer, LogEntry &entry, std::mutex *guard) noexcept;
+
+    // Collect, order, format and write out entries until stopped
+    void run() noexcept;
+    // Append formatted "entry" to "output"
+    void format(const LogEntry &entry, std::string &output) const noexcept;
+};
+
+// Initialize a program wide logger - before the configuration so that it is destroyed after it
+inline Logger LOG;
+
+#endif
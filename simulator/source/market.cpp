@@ -0,0 +1,231 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "market.h"
+
+MarketData::MarketData(const std::string &apikey, const std::string &seckey, Scheduler &scheduler) noexcept
+    : K(std::make_unique<Kraken>(apikey, seckey, scheduler)), period(60 * std::stol(CF.interval))
+{
+    if (CF.tick_file != CF.no_file)
+    {
+        recorder.open(CF.tick_file, std::ios::app);
+        recorder << std::setprecision(12);
+    }
+
+    LOG.info("MarketData constructor executed");
+}
+
+MarketData::~MarketData() noexcept
+{
+    LOG.info("MarketData destructor executed");
+}
+
+void MarketData::add_tickers(const std::vector<std::string> &names) noexcept
+{
+    for (auto const &name : names)
+    {
+        if (std::find(tickers.begin(), tickers.end(), name) == tickers.end())
+        {
+            tickers.emplace_back(name);
+        }
+    }
+    ticker_list = vec2str(tickers);
+
+    LOG.info("MarketData add_tickers() executed", {{"tickers", tickers.size()}});
+}
+
+auto MarketData::fetch_historic() noexcept -> bool
+{
+    // Servertime decides which bars are complete
+    if (!sync_time())
+    {
+        return false;
+    }
+
+    // Historic data does not change between books - fetch only tickers not yet in the store
+    std::vector<std::string> missing;
+    for (auto const &ticker : tickers)
+    {
+        if (historic.count(ticker) == 0)
+        {
+            missing.emplace_back(ticker);
+        }
+    }
+
+    long until(servertime);
+    for (auto const &stored : historic)
+    {
+        if (stored.second.size() > 0)
+        {
+            until = std::min(until, stored.second.time.back() + period);
+        }
+    }
+
+    std::vector<Historic> bars(missing.size());
+    std::vector<std::future<bool>> requests;
+    for (size_t index(0); index < missing.size(); index++)
+    {
+        requests.push_back(K->ohlc(bars[index], missing[index], CF.starttime, CF.interval));
+    }
+    if (!collect(missing, bars, requests, until))
+    {
+        return false;
+    }
+
+    // A ticker without a single complete bar since STARTTIME (new listing or STARTTIME within the last interval) cannot be traded
+    bool complete(true);
+    for (auto const &ticker : missing)
+    {
+        if (historic[ticker].size() == 0)
+        {
+            LOG.error("MarketData fetch_historic() found no complete bar", {{"ticker", ticker}, {"starttime", CF.starttime}});
+            complete = false;
+        }
+    }
+    if (!complete)
+    {
+        return false;
+    }
+    // Books built from the next snapshot need the historic data
+    refreshed = true;
+
+    LOG.info("MarketData fetch_historic() executed");
+    return true;
+}
+
+auto MarketData::refresh_historic(size_t &appended) noexcept -> bool
+{
+    long before(last_bar());
+    if (!sync_time())
+    {
+        return false;
+    }
+
+    // Request only bars from the last one held onwards
+    std::vector<Historic> bars(tickers.size());
+    std::vector<std::future<bool>> requests;
+    for (size_t index(0); index < tickers.size(); index++)
+    {
+        const Historic &stored(historic[tickers[index]]);
+        requests.push_back(K->ohlc(bars[index], tickers[index], stored.size() > 0 ? std::to_string(stored.time.back()) : CF.starttime, CF.interval));
+    }
+    if (!collect(tickers, bars, requests, servertime))
+    {
+        return false;
+    }
+
+    // A ticker whose new bar is not yet published holds back the others
+    appended = static_cast<size_t>((last_bar() - before) / period);
+    refreshed = refreshed || appended > 0;
+
+    LOG.info("MarketData refresh_historic() executed", {{"bars", appended}});
+    return true;
+}
+
+auto MarketData::until_next_bar() const noexcept -> long
+{
+    long systemtime;
+    get_system_time(systemtime);
+
+    // Bar following the last complete bar is complete one period after it started
+    return last_bar() + 2 * period - (systemtime + offset);
+}
+
+auto MarketData::poll() noexcept -> bool
+{
+    if (!sync_time() || !K->get_ticker_data(latest, ticker_list))
+    {
+        return false;
+    }
+    polls++;
+
+    // All tickers of one poll are recorded with the same time to form one snapshot
+    if (recorder.is_open())
+    {
+        long time(latest[tickers.front()].time);
+        for (auto const &ticker : tickers)
+        {
+            const Current &data(latest[ticker]);
+            recorder << time << " " << ticker << " " << data.ask << " " << data.bid << " " << data.price << "\n";
+        }
+        recorder.flush();
+    }
+
+    LOG.info("MarketData poll() executed", {{"polls", polls}});
+    return true;
+}
+
+auto MarketData::snapshot(const long &iteration) noexcept -> Snapshot
+{
+    Snapshot result;
+    result.iteration = iteration;
+    result.servertime = servertime;
+    get_system_time(result.systemtime);
+    result.latest = latest;
+    if (refreshed)
+    {
+        result.bars = historic;
+        refreshed = false;
+    }
+    return result;
+}
+
+auto MarketData::sync_time() noexcept -> bool
+{
+    long systemtime;
+    if (!K->get_server_time(servertime))
+    {
+        return false;
+    }
+    get_system_time(systemtime);
+    offset = servertime - systemtime;
+    return true;
+}
+
+auto MarketData::collect(const std::vector<std::string> &names, std::vector<Historic> &bars, std::vector<std::future<bool>> &requests, const long &until) noexcept -> bool
+{
+    // Every request is awaited even after a cancelled one - the bars it writes to must outlive it
+    bool complete(true);
+    for (size_t index(0); index < names.size(); index++)
+    {
+        if (requests[index].get() && complete)
+        {
+            historic[names[index]].append(bars[index], period, until);
+        }
+        else
+        {
+            complete = false;
+        }
+    }
+    return complete;
+}
+
+auto MarketData::last_bar() const noexcept -> long
+{
+    // Tickers without bars are left out - without any bar the bar in progress starts now
+    long last(std::numeric_limits<long>::max());
+    for (auto const &ticker : tickers)
+    {
+        auto stored(historic.find(ticker));
+        if (stored != historic.end() && stored->second.size() > 0)
+        {
+            last = std::min(last, stored->second.time.back());
+        }
+    }
+    return last == std::numeric_limits<long>::max() ? servertime : last;
+}
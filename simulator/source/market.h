@@ -0,0 +1,122 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MARKET_H
+#define MARKET_H
+
+#include "asset.h"
+#include "config.h"
+#include "kraken.h"
+#include "scheduler.h"
+#include "utils.h"
+
+// Struct for one consistent copy of the latest ticker information of all registered tickers
+// Handed from the polling thread to the books so that the next poll can run while the books work on this one
+struct Snapshot
+{
+    long iteration{0};
+    long servertime{0};
+    long systemtime{0};
+    std::map<std::string, Current> latest;
+    // Historic OHLC data of all tickers - only filled if new bars were fetched since the previous snapshot
+    std::map<std::string, Historic> bars;
+    // Books to be built anew from "bars" before the update - their portfolio was changed by a configuration reload
+    std::vector<BookConfig> rebuild;
+
+    // Read out latest ticker information of one ticker
+    [[nodiscard]] auto get_current(const std::string &ticker) const noexcept -> const Current & { return latest.at(ticker); }
+};
+
+// Class for one market-data store shared by all books
+// Every ticker is fetched once per poll no matter how many books hold it - books only copy from the store
+class MarketData
+{
+public:
+    // Constructor - takes two API keys and scheduler for pausing the API
+    MarketData(const std::string &apikey, const std::string &seckey, Scheduler &scheduler) noexcept;
+    // Destructor - clean up
+    ~MarketData() noexcept;
+    // Dummies to comply with Rule of Five
+    MarketData(const MarketData &source) = delete;
+    MarketData(MarketData &&source) = delete;
+    auto operator=(const MarketData &source) -> MarketData & = delete;
+    auto operator=(MarketData &&source) -> MarketData & = delete;
+
+    // Register tickers held by a book - tickers already registered by another book are not added again
+    void add_tickers(const std::vector<std::string> &names) noexcept;
+
+    // Fetch historic OHLC data once for every registered ticker not yet in the store
+    // Returns false if interrupted by shutdown or if a ticker has no complete bar since STARTTIME
+    // Only complete bars are kept, the bar still in progress is left out
+    // Tickers registered later are cut at the last bar of the store so that all tickers share the same timebins
+    [[nodiscard]] auto fetch_historic() noexcept -> bool;
+    // Fetch the bars published since the last complete bar for every registered ticker
+    // Returns false if interrupted by shutdown - "appended" is set to the number of new bars of the slowest ticker
+    [[nodiscard]] auto refresh_historic(size_t &appended) noexcept -> bool;
+    // Seconds until the next bar is complete on the Kraken server - negative once a published bar was not yet fetched
+    [[nodiscard]] auto until_next_bar() const noexcept -> long;
+    // Fetch servertime and latest ticker information of all registered tickers in one single API call
+    // Appends the snapshot to TICK_FILE for replay by TickReplay - returns false if interrupted by shutdown
+    [[nodiscard]] auto poll() noexcept -> bool;
+
+    // Read out latest ticker information of one ticker - execute "poll" first
+    [[nodiscard]] auto get_current(const std::string &ticker) const noexcept -> const Current & { return latest.at(ticker); }
+
+    // Copy latest ticker information and servertime of last poll into a snapshot for polling iteration "iteration"
+    // Historic data is copied along only into the first snapshot after new bars were fetched
+    [[nodiscard]] auto snapshot(const long &iteration) noexcept -> Snapshot;
+
+    // Read out servertime of last poll
+    [[nodiscard]] auto get_server_time() const noexcept -> long { return servertime; }
+    // Read out number of polls of the Kraken API so far
+    [[nodiscard]] auto number_polls() const noexcept -> long { return polls; }
+
+private:
+    // Single connection to Kraken API - requests of all tickers are queued at once and answered at the rate limit
+    std::unique_ptr<Kraken> K;
+
+    // Union of tickers of all books in order of registration and as comma separated list for the API
+    std::vector<std::string> tickers;
+    std::string ticker_list;
+
+    // Historic OHLC data and latest ticker information per ticker
+    std::map<std::string, Historic> historic;
+    std::map<std::string, Current> latest;
+
+    long servertime{0};
+    long polls{0};
+
+    // Length of one bar in seconds and difference between servertime and systemtime at the last call of the API
+    long period;
+    long offset{0};
+    // New bars were fetched since the last snapshot
+    bool refreshed{false};
+
+    // Fetch servertime and update offset to the systemtime - returns false if interrupted by shutdown
+    [[nodiscard]] auto sync_time() noexcept -> bool;
+    // Append answers of queued OHLC requests of tickers "names" to the store as they arrive - bars ending after "until" are left out
+    // Returns false if a request was cancelled by shutdown
+    [[nodiscard]] auto collect(const std::vector<std::string> &names, std::vector<Historic> &bars, std::vector<std::future<bool>> &requests, const long &until) noexcept -> bool;
+    // Servertime at which the latest bar held by all tickers started
+    [[nodiscard]] auto last_bar() const noexcept -> long;
+
+    // Recording of every polled snapshot for tick-level backtests - closed if TICK_FILE is NONE
+    std::ofstream recorder;
+};
+
+#endif
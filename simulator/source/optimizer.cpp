@@ -18,46 +18,64 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "optimizer.h"
 
-Optimizer::Optimizer(std::shared_ptr<Portfolio> portfolio) noexcept : P(std::move(portfolio))
+Optimizer::Optimizer(std::shared_ptr<Portfolio> portfolio) noexcept
+    : P(std::move(portfolio)), returns(nullptr), history_attribution(P->number_assets())
 {
-    returns = new double *[P->number_timebins()];
-    for (size_t ti(0); ti < P->number_timebins(); ti++)
+    extend_returns();
+
+    LOG.info("Optimizer constructor executed");
+}
+
+Optimizer::~Optimizer() noexcept
+{
+    for (size_t ti(0); ti < timebins; ti++)
+    {
+        delete[] returns[ti];
+    }
+    delete[] returns;
+
+    LOG.info("Optimizer destructor executed");
+}
+
+auto Optimizer::extend_returns() noexcept -> size_t
+{
+    size_t from(timebins);
+
+    // Rows already calculated are kept - only the array of row pointers is copied
+    auto **grown = new double *[P->number_timebins()];
+    std::copy(returns, returns + from, grown);
+    delete[] returns;
+    returns = grown;
+    for (size_t ti(from); ti < P->number_timebins(); ti++)
     {
         returns[ti] = new double[P->number_assets()];
     }
 
     for (size_t asset(0); asset < P->number_assets(); asset++)
     {
-        returns[0][asset] = 0.0;
-        for (size_t ti(1); ti < P->number_timebins(); ti++)
+        if (from == 0)
+        {
+            returns[0][asset] = 0.0;
+        }
+        for (size_t ti(std::max(from, static_cast<size_t>(1))); ti < P->number_timebins(); ti++)
         {
             returns[ti][asset] = 100.0 * (log(P->assets[asset]->historic.idx_price(ti)) - log(P->assets[asset]->historic.idx_price(ti - 1)));
         }
     }
 
-    std::cout << "Optimizer constructor executed." << std::endl;
+    timebins = P->number_timebins();
+    return from;
 }
 
-Optimizer::~Optimizer() noexcept
-{
-    for (size_t ti(0); ti < P->number_timebins(); ti++)
-    {
-        delete[] returns[ti];
-    }
-    delete[] returns;
-
-    std::cout << "Optimizer destructor executed." << std::endl;
-}
-
-void Optimizer::current_initialize() noexcept
+void Optimizer::current_initialize(const double &riskfree_quantity, const std::vector<double> &asset_quantities) noexcept
 {
     // Initialize RISKFREE quantity for current "initial"
-    P->assets[Configuration::RF]->set_current_quantity(CF.riskfree_quantity, Configuration::INI);
+    P->assets[Configuration::RF]->set_current_quantity(riskfree_quantity, Configuration::INI);
 
     // Initialize all other assets quantity for current "initial"
     for (size_t asset(1); asset < P->number_assets(); asset++)
     {
-        P->assets[asset]->set_current_quantity(CF.asset_quantities[asset - 1], Configuration::INI);
+        P->assets[asset]->set_current_quantity(asset_quantities[asset - 1], Configuration::INI);
     }
 
     // Initialize RISKFREE price data for current "rebalanced"
@@ -74,26 +92,33 @@ void Optimizer::current_initialize() noexcept
     current_update(Configuration::INI, Configuration::BAL);
     current_update(Configuration::INI, Configuration::LAT);
 
-    std::cout << "Optimizer current_initialize() executed." << std::endl;
+    LOG.info("Optimizer current_initialize() executed");
 }
 
-void Optimizer::current_update(const size_t &before, const size_t &after) noexcept
+Scratch::Scratch(const size_t &assets) noexcept
+    : old_quant(assets, 0.0), prices(assets, 0.0), real_weights(assets, 0.0), target_weights(assets, 0.0), new_quant(assets, 0.0)
 {
-    std::vector<double> old_quant(P->current_list_quantities(before));
-    std::vector<double> prices(P->current_list_prices(after));
-    double pv(std::inner_product(old_quant.begin(), old_quant.end(), prices.begin(), 0.0f));
+}
 
-    std::vector<double> real_weights;
-    std::transform(prices.begin(), prices.end(), old_quant.begin(), std::back_inserter(real_weights), std::multiplies<double>());
-    std::transform(real_weights.begin(), real_weights.end(), real_weights.begin(), [&pv](const auto &rw) { return rw / pv; });
+void Optimizer::rebalance(Scratch &scratch) noexcept
+{
+    const std::vector<double> &old_quant(scratch.old_quant);
+    const std::vector<double> &prices(scratch.prices);
+    const std::vector<double> &target_weights(scratch.target_weights);
+
+    double pv(std::inner_product(old_quant.begin(), old_quant.end(), prices.begin(), 0.0));
 
-    std::vector<double> target_weights = predict_weights();
+    std::transform(prices.begin(), prices.end(), old_quant.begin(), scratch.real_weights.begin(), [&pv](const auto &price, const auto &quant) { return price * quant / pv; });
 
+    // Threshold may be changed by a configuration reload - read once per rebalancing
+    const double weight_diff(CF.settings().weight_diff);
     double cash_delta(0.0);
+    scratch.traded = 0.0;
+    scratch.fees = 0.0;
 
-    for (size_t asset(1); asset < P->number_assets(); asset++)
+    for (size_t asset(1); asset < old_quant.size(); asset++)
     {
-        if (fabs(target_weights[asset] - real_weights[asset]) > CF.weight_diff)
+        if (fabs(target_weights[asset] - scratch.real_weights[asset]) > weight_diff)
         {
             double target_quantity(pv * target_weights[asset] / prices[asset]);
 
@@ -102,61 +127,345 @@ void Optimizer::current_update(const size_t &before, const size_t &after) noexce
             double real_fee(fabs(target_quantity - old_quant[asset]) * prices[asset] * CF.trade_fee);
 
             cash_delta -= (target_quantity - old_quant[asset]) * prices[asset] + real_fee;
+            scratch.traded += fabs(target_quantity - old_quant[asset]) * prices[asset];
+            scratch.fees += real_fee;
 
-            P->assets[asset]->set_current_quantity(target_quantity, after);
+            scratch.new_quant[asset] = target_quantity;
         }
         else
         {
-            P->assets[asset]->set_current_quantity(old_quant[asset], after);
+            scratch.new_quant[asset] = old_quant[asset];
         }
     }
 
-    double cash_balance(old_quant[Configuration::RF] + cash_delta);
-    P->assets[Configuration::RF]->set_current_quantity(cash_balance, after);
+    scratch.new_quant[Configuration::RF] = old_quant[Configuration::RF] + cash_delta;
+}
+
+template <typename S>
+void StrategyOptimizer<S>::current_update(const size_t &before, const size_t &after) noexcept
+{
+    P->current_fill_quantities(before, scratch.old_quant);
+    P->current_fill_prices(after, scratch.prices);
+
+    // Latest historic timebin is the most recent information available to the strategy
+    predict_weights(P->number_timebins() - 1, scratch);
+    rebalance(scratch);
 
-    std::cout << "Optimizer current_update() executed." << std::endl;
+    for (size_t asset(0); asset < P->number_assets(); asset++)
+    {
+        P->assets[asset]->set_current_quantity(scratch.new_quant[asset], after);
+    }
+
+    LOG.debug("Optimizer current_update() executed");
 }
 
-void Optimizer::history_calculate() noexcept
+template <typename S>
+void StrategyOptimizer<S>::history_calculate() noexcept
 {
+    // Scratch arena of this run - the loop below does not touch the heap
+    Scratch run(P->number_assets());
+    size_t allocations(allocation_count());
+
+    // Analytics and attribution are accumulated along the backtest - no second pass over the portfolio values
+    history_analytics = Analytics();
+    P->idx_fill_quantities(0, run.new_quant);
+    P->idx_fill_prices(0, run.prices);
+    double pv(std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0));
+    history_analytics.update(P->idx_time(0), pv, 0.0, 0.0, 1.0 - run.new_quant[Configuration::RF] / pv);
+    history_attribution.start(run.new_quant, run.prices);
+
     for (size_t ti(1); ti < P->number_timebins(); ti++)
     {
-        std::vector<double> old_quant(P->idx_list_quantities(ti - 1));
-        std::vector<double> prices(P->idx_list_prices(ti));
+        P->idx_fill_quantities(ti - 1, run.old_quant);
+        P->idx_fill_prices(ti, run.prices);
+
+        predict_weights(ti, run);
+        rebalance(run);
 
-        double pv(std::inner_product(old_quant.begin(), old_quant.end(), prices.begin(), 0.0f));
+        for (size_t asset(0); asset < P->number_assets(); asset++)
+        {
+            P->assets[asset]->set_historic_quantity(run.new_quant[asset], ti);
+        }
 
-        std::vector<double> real_weights;
-        std::transform(prices.begin(), prices.end(), old_quant.begin(), std::back_inserter(real_weights), std::multiplies<double>());
-        std::transform(real_weights.begin(), real_weights.end(), real_weights.begin(), [&pv](const auto &rw) { return rw / pv; });
+        pv = std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0);
+        history_analytics.update(P->idx_time(ti), pv, run.traded, run.fees, 1.0 - run.new_quant[Configuration::RF] / pv);
+        history_attribution.update(run.new_quant, run.prices);
+    }
 
-        std::vector<double> target_weights = predict_weights();
+    history_allocations = allocation_count() - allocations;
 
-        double cash_delta(0.0);
+    if (allocations_counted)
+    {
+        LOG.info("Optimizer history_calculate() loop finished", {{"allocations", history_allocations}});
+    }
+    LOG.info("Optimizer history_calculate() executed");
+}
 
-        for (size_t asset(1); asset < P->number_assets(); asset++)
+template <typename S>
+void StrategyOptimizer<S>::history_extend() noexcept
+{
+    size_t from(extend_returns());
+
+    // Same step as in history_calculate() - one prediction and rebalancing per new bar
+    for (size_t ti(std::max(from, static_cast<size_t>(1))); ti < P->number_timebins(); ti++)
+    {
+        P->idx_fill_quantities(ti - 1, scratch.old_quant);
+        P->idx_fill_prices(ti, scratch.prices);
+
+        predict_weights(ti, scratch);
+        rebalance(scratch);
+
+        for (size_t asset(0); asset < P->number_assets(); asset++)
         {
-            if (fabs(target_weights[asset] - real_weights[asset]) > CF.weight_diff)
-            {
-                double target_quantity(pv * target_weights[asset] / prices[asset]);
+            P->assets[asset]->set_historic_quantity(scratch.new_quant[asset], ti);
+        }
 
-                double pre_fee(fabs(target_quantity - old_quant[asset]) * prices[asset] * CF.trade_fee);
-                target_quantity -= 0.5 * pre_fee / prices[asset];
-                double real_fee(fabs(target_quantity - old_quant[asset]) * prices[asset] * CF.trade_fee);
+        double pv(std::inner_product(scratch.new_quant.begin(), scratch.new_quant.end(), scratch.prices.begin(), 0.0));
+        history_analytics.update(P->idx_time(ti), pv, scratch.traded, scratch.fees, 1.0 - scratch.new_quant[Configuration::RF] / pv);
+        history_attribution.update(scratch.new_quant, scratch.prices);
+    }
+
+    LOG.info("Optimizer history_extend() executed", {{"bars", P->number_timebins() - from}});
+}
+
+template <typename S>
+auto StrategyOptimizer<S>::walk_forward(const size_t &train, const size_t &test) noexcept -> WalkForward
+{
+    WalkForward result(train, test, P->number_timebins());
+
+    // Tasks on the shared pool pulling the next window until all windows are done
+    std::atomic<size_t> next_window{0};
+    auto worker = [this, &result, &next_window]() {
+        Scratch run(P->number_assets());
+        for (size_t window(next_window++); window < result.windows.size(); window = next_window++)
+        {
+            walk_window(result.windows[window], run);
+        }
+    };
+
+    size_t tasks(std::min(POOL.number_workers(), result.windows.size()));
+    POOL.fork_join(Priority::Low, tasks, worker);
 
-                cash_delta -= (target_quantity - old_quant[asset]) * prices[asset] + real_fee;
+    result.stitch();
+
+    LOG.info("Optimizer walk_forward() executed", {{"windows", result.windows.size()}, {"tasks", tasks}});
+    return result;
+}
+
+template <typename S>
+void StrategyOptimizer<S>::walk_window(Window &window, Scratch &run) noexcept
+{
+    // Strategy only sees the training period before it starts trading
+    S window_strategy(prototype);
+    window_strategy.train(returns, window.train_begin, window.test_begin, run.target_weights);
+
+    // Every window starts from the initial quantities of the portfolio
+    P->idx_fill_quantities(0, run.new_quant);
+    P->idx_fill_prices(window.test_begin, run.prices);
+    double pv_start(std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0));
+    Analytics analytics;
+    analytics.update(P->idx_time(window.test_begin), pv_start, 0.0, 0.0, 1.0 - run.new_quant[Configuration::RF] / pv_start);
+
+    window.equity.reserve(window.test_end - window.test_begin);
+    for (size_t ti(window.test_begin); ti < window.test_end; ti++)
+    {
+        std::copy(run.new_quant.begin(), run.new_quant.end(), run.old_quant.begin());
+        P->idx_fill_prices(ti, run.prices);
 
-                P->assets[asset]->set_historic_quantity(target_quantity, ti);
+        window_strategy.predict_weights(returns, ti, run.target_weights);
+        rebalance(run);
+
+        double pv(std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0));
+        window.equity.emplace_back(pv / pv_start);
+        analytics.update(P->idx_time(ti), pv, run.traded, run.fees, 1.0 - run.new_quant[Configuration::RF] / pv);
+    }
+
+    window.performance = analytics.performance();
+    window.volatility = analytics.volatility();
+    window.drawdown = analytics.drawdown();
+    window.turnover = analytics.turnover();
+    window.fees = analytics.fees();
+}
+
+template <typename S>
+auto StrategyOptimizer<S>::monte_carlo(const Scenario &scenario, const size_t &paths, const size_t &length) noexcept -> ScenarioResult
+{
+    auto start(std::chrono::high_resolution_clock::now());
+
+    ScenarioResult result;
+    result.final_value = std::vector<double>(paths, 0.0);
+    result.drawdown = std::vector<double>(paths, 0.0);
+    result.turnover = std::vector<double>(paths, 0.0);
+
+    // Tasks claim batches of paths - one strategy instance, scratch arena and batch buffer per task
+    static constexpr size_t batch{64};
+    std::atomic<size_t> next_path{0};
+    auto worker = [this, &scenario, &result, &next_path, &paths, &length]() {
+        const size_t assets(P->number_assets());
+        const size_t rows(length + 1);
+        S path_strategy(prototype);
+        Scratch run(assets);
+        // Returns of all paths of a batch in one contiguous block - row ti of path bi starts at (bi * rows + ti) * assets
+        std::vector<double> buffer(batch * rows * assets, 0.0);
+        std::vector<double> growth(batch * rows * assets, 1.0);
+        std::vector<double *> path(batch * rows, nullptr);
+        for (size_t ri(0); ri < batch * rows; ri++)
+        {
+            path[ri] = buffer.data() + ri * assets;
+        }
+
+        for (size_t first(next_path.fetch_add(batch)); first < paths; first = next_path.fetch_add(batch))
+        {
+            const size_t count(std::min(first + batch, paths) - first);
+            for (size_t bi(0); bi < count; bi++)
+            {
+                scenario.generate(static_cast<unsigned long>(first + bi), length, path.data() + bi * rows);
             }
-            else
+
+            // Price growth factors of the whole batch in one pass - returns are stored in percent of log prices
+            auto batch_end(buffer.begin() + static_cast<long>(count * rows * assets));
+            std::transform(buffer.begin(), batch_end, growth.begin(), [](const double &value) { return exp(value / 100.0); });
+
+            for (size_t bi(0); bi < count; bi++)
             {
-                P->assets[asset]->set_historic_quantity(old_quant[asset], ti);
+                // Every path starts from the initial quantities at the latest historic prices with a clean strategy
+                path_strategy.reset();
+                P->idx_fill_quantities(0, run.new_quant);
+                P->idx_fill_prices(P->number_timebins() - 1, run.prices);
+                double pv_start(std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0));
+                double pv_last(pv_start), peak(pv_start), drawdown(0.0), turnover(0.0);
+
+                for (size_t ti(1); ti <= length; ti++)
+                {
+                    const double *factor(growth.data() + (bi * rows + ti) * assets);
+                    std::copy(run.new_quant.begin(), run.new_quant.end(), run.old_quant.begin());
+                    std::transform(run.prices.begin(), run.prices.end(), factor, run.prices.begin(), std::multiplies<>());
+
+                    path_strategy.predict_weights(path.data() + bi * rows, ti, run.target_weights);
+                    rebalance(run);
+
+                    double pv(std::inner_product(run.new_quant.begin(), run.new_quant.end(), run.prices.begin(), 0.0));
+                    turnover += run.traded / pv_last;
+                    peak = std::max(peak, pv);
+                    drawdown = std::max(drawdown, 1.0 - pv / peak);
+                    pv_last = pv;
+                }
+
+                result.final_value[first + bi] = pv_last / pv_start;
+                result.drawdown[first + bi] = drawdown;
+                result.turnover[first + bi] = turnover;
             }
         }
+    };
 
-        double cash_balance(old_quant[Configuration::RF] + cash_delta);
-        P->assets[Configuration::RF]->set_historic_quantity(cash_balance, ti);
+    size_t tasks(std::min(POOL.number_workers(), (paths + batch - 1) / batch));
+    POOL.fork_join(Priority::Low, tasks, worker);
+
+    auto end(std::chrono::high_resolution_clock::now());
+    auto seconds(static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()) / 1000.0);
+
+    LOG.info("Optimizer monte_carlo() executed", {{"paths", paths}, {"timebins", length}, {"tasks", tasks}, {"seconds", seconds}});
+    return result;
+}
+
+template <typename S>
+auto StrategyOptimizer<S>::tick_backtest(const TickReplay &replay) noexcept -> TickResult
+{
+    TickResult result;
+    S tick_strategy(prototype);
+    Scratch run(P->number_assets());
+    std::vector<double> bids(P->number_assets(), 0.0);
+    const std::vector<long> &bars(P->assets[Configuration::RF]->historic.time);
+
+    // Start from the initial quantities at the latest historic prices - riskfree stays at one
+    P->idx_fill_quantities(0, run.new_quant);
+    P->idx_fill_prices(P->number_timebins() - 1, run.prices);
+    std::copy(run.prices.begin(), run.prices.end(), bids.begin());
+    double pv_last(0.0), peak(0.0);
+
+    // Rebalance once all ticks of one snapshot have been applied
+    auto snapshot = [&](const long &time) {
+        std::copy(run.new_quant.begin(), run.new_quant.end(), run.old_quant.begin());
+        if (result.snapshots == 0)
+        {
+            // Performance is measured from the first recorded snapshot on
+            pv_last = std::inner_product(run.old_quant.begin(), run.old_quant.end(), bids.begin(), 0.0);
+            peak = pv_last;
+            result.value_start = pv_last;
+        }
+
+        // Strategy sees the historic timebins up to the snapshot only
+        auto bar(static_cast<size_t>(std::upper_bound(bars.begin(), bars.end(), time) - bars.begin()));
+        tick_strategy.predict_weights(returns, bar > 0 ? bar - 1 : 0, run.target_weights);
+        rebalance(run);
+
+        double pv(std::inner_product(run.new_quant.begin(), run.new_quant.end(), bids.begin(), 0.0));
+        result.turnover += run.traded / pv_last;
+        result.fees += run.fees;
+        result.trades += run.traded > 0.0 ? 1 : 0;
+        result.snapshots++;
+        peak = std::max(peak, pv);
+        result.drawdown = std::max(result.drawdown, 1.0 - pv / peak);
+        pv_last = pv;
+    };
+
+    auto start(std::chrono::high_resolution_clock::now());
+
+    // Producer thread feeds the events in timestamp order, this thread consumes them
+    SpscQueue<Tick> queue(4096);
+    std::atomic<bool> finished{false};
+    std::thread producer([&replay, &queue, &finished]() {
+        for (auto const &tick : replay.ticks)
+        {
+            while (!queue.try_push(tick))
+            {
+                std::this_thread::yield();
+            }
+        }
+        finished.store(true, std::memory_order_release);
+    });
+
+    Tick tick;
+    long time(std::numeric_limits<long>::min());
+    while (true)
+    {
+        if (!queue.try_pop(tick))
+        {
+            if (!finished.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            // Producer may have pushed its last ticks between the failed pop and reading the flag
+            if (!queue.try_pop(tick))
+            {
+                break;
+            }
+        }
+        if (tick.time != time && result.events > 0)
+        {
+            snapshot(time);
+        }
+        time = tick.time;
+        run.prices[tick.asset] = tick.price;
+        bids[tick.asset] = tick.bid;
+        result.events++;
+    }
+    if (result.events > 0)
+    {
+        snapshot(time);
     }
+    producer.join();
+
+    auto end(std::chrono::high_resolution_clock::now());
+    result.seconds = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / 1000000.0;
+    result.value_end = pv_last;
 
-    std::cout << "Optimizer history_calculate() executed." << std::endl;
+    LOG.info("Optimizer tick_backtest() executed", {{"events", result.events}});
+    return result;
 }
+
+// Instantiate the optimizer for all strategies known to make_optimizer()
+template class StrategyOptimizer<Deinvest>;
+template class StrategyOptimizer<EqualWeight>;
+template class StrategyOptimizer<RiskParity>;
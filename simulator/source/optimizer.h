@@ -19,46 +19,149 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef OPTIMIZER_H
 #define OPTIMIZER_H
 
+#include "allocation.h"
+#include "analytics.h"
+#include "attribution.h"
 #include "config.h"
+#include "executor.h"
 #include "portfolio.h"
+#include "queue.h"
+#include "riskparity.h"
+#include "scenario.h"
+#include "tick.h"
 #include "utils.h"
+#include "walkforward.h"
+
+// Scratch arena of one optimization run - all buffers sized once from the number of assets and reused each timebin
+struct Scratch
+{
+    explicit Scratch(const size_t &assets) noexcept;
+    // Quantities before rebalancing and prices at which to rebalance
+    std::vector<double> old_quant;
+    std::vector<double> prices;
+    // Weights before rebalancing and weights predicted by the strategy
+    std::vector<double> real_weights;
+    std::vector<double> target_weights;
+    // Quantities after rebalancing
+    std::vector<double> new_quant;
+    // Value traded and fees paid by the last rebalancing
+    double traded{0.0};
+    double fees{0.0};
+};
 
 // Class for optimizing and manipulating a portfolio
+// Interface independent of the strategy - a concrete optimizer is obtained via make_optimizer()
 class Optimizer
 {
 public:
     // Constructor - takes portfolio
     explicit Optimizer(std::shared_ptr<Portfolio> portfolio) noexcept;
     // Destructor - cleans up
-    ~Optimizer() noexcept;
+    virtual ~Optimizer() noexcept;
     // Dummies to comply with the Rule of Five
     Optimizer(const Optimizer &source) noexcept = delete;
     Optimizer(Optimizer &&source) noexcept = delete;
     auto operator=(const Optimizer &source) noexcept -> Optimizer & = delete;
     auto operator=(Optimizer &&source) noexcept -> Optimizer & = delete;
 
-    // Initialize the first element in current one-time ticker information vectors
+    // Initialize the first element in current one-time ticker information vectors with the quantities of the book
     // Accesses individual assets and manipulates their quantities directly
-    void current_initialize() noexcept;
+    void current_initialize(const double &riskfree_quantity, const std::vector<double> &asset_quantities) noexcept;
 
     // Perform optimization of between the "before" and "after" elements
     // Accesses individual assets and optimizes quantities of current one-time ticker vectors
-    void current_update(const size_t &before, const size_t &after) noexcept;
+    virtual void current_update(const size_t &before, const size_t &after) noexcept = 0;
 
     // Perform optimization on historic data in portfolio
     // Accesses individual assets and optimizes quantities of historic data struct
-    void history_calculate() noexcept;
+    virtual void history_calculate() noexcept = 0;
 
-private:
+    // Continue the optimization on historic data over the timebins appended to the portfolio since the last call
+    // Steps the strategy once per new bar and extends analytics and attribution of the historic backtest
+    virtual void history_extend() noexcept = 0;
+
+    // Read out analytics and attribution of the last optimization on historic data
+    [[nodiscard]] auto get_history_analytics() const noexcept -> const Analytics & { return history_analytics; }
+    [[nodiscard]] auto get_history_attribution() const noexcept -> const Attribution & { return history_attribution; }
+    // Read out heap allocations of the last optimization on historic data - always zero without ACCPO_COUNT_ALLOCATIONS
+    [[nodiscard]] auto get_history_allocations() const noexcept -> size_t { return history_allocations; }
+
+    // Read out historic returns of all assets (timebins x assets, in percent of log prices)
+    [[nodiscard]] auto get_returns() const noexcept -> double ** { return returns; }
+
+    // Perform walk-forward backtest on historic data in rolling windows of "train" and "test" timebins
+    // Windows run concurrently on the shared pool and do not modify the portfolio
+    [[nodiscard]] virtual auto walk_forward(const size_t &train, const size_t &test) noexcept -> WalkForward = 0;
+
+    // Run the strategy over "paths" synthetic paths of "length" timebins starting at the latest historic prices
+    // Paths are processed in batches on the shared pool and do not modify the portfolio
+    [[nodiscard]] virtual auto monte_carlo(const Scenario &scenario, const size_t &paths, const size_t &length) noexcept -> ScenarioResult = 0;
+
+    // Replay recorded ticker snapshots in timestamp order and rebalance on every snapshot at its last prices
+    // Positions are valued at bid as in live trading - does not modify the portfolio
+    [[nodiscard]] virtual auto tick_backtest(const TickReplay &replay) noexcept -> TickResult = 0;
+
+protected:
     // Portfolio on which optimization should takes place
     std::shared_ptr<Portfolio> P;
 
     // Calculate returns - used in optimization
     double **returns;
+    // Number of timebins with returns - lags behind the portfolio while new bars are appended
+    size_t timebins{0};
+
+    // Grow returns to the timebins of the portfolio and calculate them for the new timebins - returns first new timebin
+    auto extend_returns() noexcept -> size_t;
+
+    // Analytics of the portfolio values and attribution of the profit and loss calculated by history_calculate()
+    Analytics history_analytics;
+    Attribution history_attribution;
+    size_t history_allocations{0};
+
+    // Rebalance "old_quant" at "prices" towards "target_weights" and store result in "new_quant" of scratch
+    // Trades only if weight difference exceeds threshold, fees are paid from the riskfree asset
+    static void rebalance(Scratch &scratch) noexcept;
+};
+
+// Optimizer specialised at compile time for one strategy "S" (see strategy.h)
+// Calls into the strategy are direct and can be inlined into the backtest loop
+template <typename S>
+class StrategyOptimizer final : public Optimizer
+{
+public:
+    // Constructor - takes portfolio and forwards remaining arguments to the constructor of the strategy
+    template <typename... Args>
+    explicit StrategyOptimizer(std::shared_ptr<Portfolio> portfolio, Args &&... args) noexcept
+        : Optimizer(std::move(portfolio)), prototype(std::forward<Args>(args)...), strategy(prototype), scratch(P->number_assets()) {}
+    // Destructor - cleans up
+    ~StrategyOptimizer() noexcept override = default;
+    // Dummies to comply with the Rule of Five
+    StrategyOptimizer(const StrategyOptimizer &source) noexcept = delete;
+    StrategyOptimizer(StrategyOptimizer &&source) noexcept = delete;
+    auto operator=(const StrategyOptimizer &source) noexcept -> StrategyOptimizer & = delete;
+    auto operator=(StrategyOptimizer &&source) noexcept -> StrategyOptimizer & = delete;
+
+    void current_update(const size_t &before, const size_t &after) noexcept override;
+    void history_calculate() noexcept override;
+    void history_extend() noexcept override;
+    [[nodiscard]] auto walk_forward(const size_t &train, const size_t &test) noexcept -> WalkForward override;
+    [[nodiscard]] auto monte_carlo(const Scenario &scenario, const size_t &paths, const size_t &length) noexcept -> ScenarioResult override;
+    [[nodiscard]] auto tick_backtest(const TickReplay &replay) noexcept -> TickResult override;
+
+private:
+    // Strategy as constructed and never used - copied wherever a run must start from a clean state
+    const S prototype;
+    // Strategy predicting the portfolio weights - held by value for static dispatch
+    S strategy;
+
+    // Scratch arena reused by every call of current_update()
+    Scratch scratch;
+
+    // Predict portfolio weights (individual asset quantities) using data up to timebin ti into "target_weights" of scratch
+    void predict_weights(const size_t &ti, Scratch &run) noexcept { strategy.predict_weights(returns, ti, run.target_weights); }
 
-    // Predict portfolio weights (individual asset quantities)
-    // Invoke function for deep reinforcement learning algorithm
-    auto predict_weights() noexcept -> const std::vector<double>;
+    // Run training and testing of one walk-forward window with its own strategy instance and scratch arena
+    void walk_window(Window &window, Scratch &run) noexcept;
 };
 
 #endif
@@ -0,0 +1,250 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "pipeline.h"
+
+// Push "element" into "queue", sleeping while the queue is full - returns false if shutdown was requested meanwhile
+// The consumer notifies the scheduler after every pop, so the producer never polls
+template <typename T>
+static auto push_waiting(SpscQueue<T> &queue, T &&element, Scheduler &scheduler) noexcept -> bool
+{
+    while (!queue.try_push(std::move(element)))
+    {
+        if (!scheduler.wait([&queue]() { return !queue.full(); }, true))
+        {
+            return false;
+        }
+    }
+    scheduler.notify();
+    return true;
+}
+
+// Pop into "element" from "queue", sleeping while the queue is empty - returns false once "upstream" stopped and the queue is drained
+// Not interrupted by shutdown - the upstream stage clears its flag and notifies when it stops
+template <typename T>
+static auto pop_waiting(SpscQueue<T> &queue, T &element, const std::atomic<bool> &upstream, Scheduler &scheduler) noexcept -> bool
+{
+    while (true)
+    {
+        // Flag is read before popping so that no element pushed before the upstream stopped is lost
+        bool running(upstream.load(std::memory_order_acquire));
+        if (queue.try_pop(element))
+        {
+            scheduler.notify();
+            return true;
+        }
+        if (!running)
+        {
+            return false;
+        }
+        static_cast<void>(scheduler.wait([&queue, &upstream]() { return !queue.empty() || !upstream.load(std::memory_order_acquire); }, false));
+    }
+}
+
+Pipeline::Pipeline(MarketData &market, std::vector<std::unique_ptr<Book>> &books, SinkWriter &sinks, Scheduler &scheduler) noexcept
+    : market(market), books(books), sinks(sinks), scheduler(scheduler)
+{
+    LOG.info("Pipeline constructor executed");
+}
+
+Pipeline::~Pipeline() noexcept
+{
+    LOG.info("Pipeline destructor executed", {{"iterations", printed}});
+}
+
+void Pipeline::run() noexcept
+{
+    LOG.info("Program polls tickers and refreshes historic data after every new bar", {{"poll_seconds", CF.settings().pause_program}, {"bar_delay", CF.bar_delay}, {"interval", CF.interval}});
+    LOG.text("Press KEY + ENTER or send SIGINT/SIGTERM to exit loop and terminate program.\n");
+
+    std::thread optimize_thread(&Pipeline::optimize, this);
+    std::thread output_thread(&Pipeline::output, this);
+
+    fetch();
+
+    optimize_thread.join();
+    output_thread.join();
+}
+
+void Pipeline::fetch() noexcept
+{
+    long iteration(1);
+    // Ticker polls are due at fixed deadlines - time spent polling does not delay the next poll
+    auto next_poll(std::chrono::steady_clock::now() + std::chrono::seconds(CF.settings().pause_program));
+    // Refresh of historic data is due when the next bar is published on the Kraken server
+    auto next_bar(std::chrono::steady_clock::now() + std::chrono::seconds(std::max(market.until_next_bar() + CF.bar_delay, 0L)));
+    // Configuration snapshot whose portfolio the books were built with - reloads are picked up before the next poll
+    const Settings *applied(&CF.settings());
+    while (!scheduler.stopping())
+    {
+        // Put the stage to rest until the next poll or bar is due - wakes immediately on shutdown
+        bool bar_due(next_bar <= next_poll);
+        if (!scheduler.wait_until(bar_due ? next_bar : next_poll))
+        {
+            break;
+        }
+
+        if (bar_due)
+        {
+            size_t appended(0);
+            if (!market.refresh_historic(appended))
+            {
+                break;
+            }
+            // Kraken may publish a bar late - retry with the ticker polls until it arrives
+            long wait(appended > 0 ? market.until_next_bar() + CF.bar_delay : CF.settings().pause_program);
+            next_bar = std::chrono::steady_clock::now() + std::chrono::seconds(std::max(wait, 0L));
+        }
+        else
+        {
+            next_poll = std::max(next_poll + std::chrono::seconds(CF.settings().pause_program), std::chrono::steady_clock::now());
+        }
+
+        // A changed ASSET_LIST only backfills the tickers not yet in the store - the book is rebuilt from the store
+        std::vector<BookConfig> rebuild;
+        const Settings &settings(CF.settings());
+        if (&settings != applied)
+        {
+            if (CF.books.front().name == CF.default_book && (settings.assets_names != applied->assets_names || settings.asset_quantities != applied->asset_quantities))
+            {
+                market.add_tickers(settings.assets_names);
+                if (!market.fetch_historic())
+                {
+                    break;
+                }
+                rebuild.push_back(BookConfig{CF.default_book, CF.strategy, CF.riskfree_quantity, settings.assets_names, settings.asset_quantities});
+            }
+            applied = &settings;
+        }
+
+        // Every refresh of bars is followed by a ticker poll so that the books trade on the new bar right away
+        if (!market.poll())
+        {
+            break;
+        }
+
+        // Books never read the store directly - they work on a copy while the next poll fills the store
+        Snapshot snapshot(market.snapshot(iteration));
+        snapshot.rebuild = std::move(rebuild);
+        if (!push_waiting(snapshots, std::move(snapshot), scheduler))
+        {
+            break;
+        }
+        iteration++;
+    }
+
+    fetching.store(false, std::memory_order_release);
+    scheduler.notify();
+}
+
+void Pipeline::optimize() noexcept
+{
+    Snapshot snapshot;
+    while (pop_waiting(snapshots, snapshot, fetching, scheduler))
+    {
+        // Snapshots left over at shutdown are not traded on anymore
+        if (scheduler.stopping())
+        {
+            break;
+        }
+
+        // Rebuilt books start over from the initial quantities and are optimized on the historic data again
+        // Optimization and backtests of a rebuilt book take long - they run on the pool while this stage goes on
+        if (!snapshot.rebuild.empty())
+        {
+            auto copy(std::make_shared<const Snapshot>(snapshot));
+            for (auto const &config : snapshot.rebuild)
+            {
+                rebuilding.push_back(Rebuild{config.name, POOL.submit(Priority::Normal, [config, copy]() {
+                                                 auto book(std::make_unique<Book>(config, *copy));
+                                                 book->initialize();
+                                                 return book;
+                                             })});
+            }
+        }
+
+        // Successors are swapped in in order of the reloads, so the latest reload of a book always wins
+        while (!rebuilding.empty() && rebuilding.front().book.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            auto held(std::find_if(books.begin(), books.end(), [this](const std::unique_ptr<Book> &book) { return book->get_name() == rebuilding.front().name; }));
+            if (held != books.end())
+            {
+                *held = rebuilding.front().book.get();
+            }
+            rebuilding.pop_front();
+        }
+
+        Frame frame;
+        frame.iteration = snapshot.iteration;
+
+        std::stringstream header;
+        header << "###############################################################################################################" << std::endl;
+        header << "Infinite polling loop iteration number " << std::to_string(snapshot.iteration) << std::endl;
+        header << "Current servertime is: " << time2str(snapshot.servertime) << std::endl;
+        header << "Current systemtime is: " << time2str(snapshot.systemtime) << std::endl;
+        // Check synchronization between Kraken server and local system
+        header << "The current time delay is " << fabs(static_cast<double>(snapshot.servertime - snapshot.systemtime)) << " seconds." << std::endl;
+        frame.text = header.str();
+
+        // Optimize every book on the same snapshot - books are independent and run concurrently on the shared pool
+        std::vector<std::vector<Record>> records(books.size());
+        std::vector<std::future<std::string>> updates;
+        updates.reserve(books.size());
+        for (size_t index(0); index < books.size(); index++)
+        {
+            updates.push_back(POOL.submit(Priority::High, [this, &snapshot, &records, index]() { return books[index]->update(snapshot, records[index]); }));
+        }
+
+        // Output and records keep the order of the books - the sink queue takes records from this thread only
+        for (size_t index(0); index < books.size(); index++)
+        {
+            frame.text += POOL.wait(updates[index]);
+            for (auto const &record : records[index])
+            {
+                sinks.publish(record);
+            }
+        }
+        frame.text += POOL.output().str();
+
+        if (!push_waiting(frames, std::move(frame), scheduler))
+        {
+            break;
+        }
+    }
+
+    // Rebuilds still running use the pool and the logger - they finish before the stage stops
+    for (auto &entry : rebuilding)
+    {
+        static_cast<void>(POOL.wait(entry.book));
+    }
+
+    optimizing.store(false, std::memory_order_release);
+    scheduler.notify();
+}
+
+void Pipeline::output() noexcept
+{
+    // Frames already optimized are always printed, also after shutdown was requested
+    Frame frame;
+    while (pop_waiting(frames, frame, optimizing, scheduler))
+    {
+        LOG.text(std::move(frame.text));
+        printed = frame.iteration;
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "book.h"
+#include "config.h"
+#include "executor.h"
+#include "market.h"
+#include "queue.h"
+#include "scheduler.h"
+#include "sink.h"
+#include "utils.h"
+
+// Struct for the output of all books in one polling iteration - handed from the optimize to the output stage
+struct Frame
+{
+    long iteration{0};
+    std::string text;
+};
+
+// Class for the infinite polling loop as three stages on three threads connected by bounded lock-free queues
+// Idle stages sleep on the scheduler until an element arrives, room is freed in the queue or the upstream stage stops
+// Fetch polls the market at fixed deadlines and refreshes historic data at bar boundaries of the Kraken server
+// Optimize updates all books on a snapshot, output prints the result
+// Only the optimize stage touches the books - fetch of iteration N+1 overlaps optimization and output of iteration N
+class Pipeline
+{
+public:
+    // Constructor - takes the shared market-data store, the initialized books, the sinks and the scheduler
+    Pipeline(MarketData &market, std::vector<std::unique_ptr<Book>> &books, SinkWriter &sinks, Scheduler &scheduler) noexcept;
+    // Destructor - clean up
+    ~Pipeline() noexcept;
+    // Dummies to comply with Rule of Five
+    Pipeline(const Pipeline &source) = delete;
+    Pipeline(Pipeline &&source) = delete;
+    auto operator=(const Pipeline &source) -> Pipeline & = delete;
+    auto operator=(Pipeline &&source) -> Pipeline & = delete;
+
+    // Run all stages until shutdown is requested - returns after all stages finished
+    void run() noexcept;
+
+private:
+    MarketData &market;
+    std::vector<std::unique_ptr<Book>> &books;
+    SinkWriter &sinks;
+    Scheduler &scheduler;
+
+    // Few entries are enough - a stage falling behind by more than a couple of polls makes the producer wait
+    static constexpr size_t depth{4};
+    SpscQueue<Snapshot> snapshots{depth};
+    SpscQueue<Frame> frames{depth};
+
+    // Cleared by a stage when it produces no more elements - the next stage drains its queue and stops
+    std::atomic<bool> fetching{true};
+    std::atomic<bool> optimizing{true};
+
+    // Number of polling iterations fully printed
+    long printed{0};
+
+    // Book rebuilt and initialized on the shared pool after a configuration reload
+    struct Rebuild
+    {
+        std::string name;
+        std::future<std::unique_ptr<Book>> book;
+    };
+    // Rebuilds in order of the reloads - the old book keeps trading until its successor is ready
+    std::deque<Rebuild> rebuilding;
+
+    // Stages of the pipeline - each one runs on its own thread
+    void fetch() noexcept;
+    void optimize() noexcept;
+    void output() noexcept;
+};
+
+#endif
@@ -19,35 +19,44 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "portfolio.h"
 
 Portfolio::Portfolio(std::unique_ptr<Asset> &&asset) noexcept
+    : marks(std::make_shared<DirtyMarks>()), current_values(CF.idx2str.size(), 0.0), current_weights(CF.idx2str.size(), 0.0)
 {
+    marks->current.resize(CF.idx2str.size(), true);
     add_asset(std::move(asset));
-    std::cout << "Portfolio constructor executed." << std::endl;
+    LOG.info("Portfolio constructor executed");
 }
 
 Portfolio::~Portfolio() noexcept
 {
-    std::cout << "Portfolio destructor executed." << std::endl;
+    LOG.info("Portfolio destructor executed");
 }
 
 void Portfolio::add_asset(std::unique_ptr<Asset> &&asset) noexcept
 {
     assets.emplace_back(std::move(asset));
-    std::cout << "Portfolio add_asset executed for: " << assets.back()->get_name() << std::endl;
+    assets.back()->share_marks(marks);
+
+    // All aggregates change with a new asset
+    marks->historic_from = 0;
+    std::fill(marks->current.begin(), marks->current.end(), true);
+    LOG.debug("Portfolio add_asset executed", {{"asset", assets.back()->get_name()}});
 }
 
 auto Portfolio::idx_total_value(const size_t &idx) const noexcept -> double
 {
-    std::vector<double> values;
-    std::transform(assets.begin(), assets.end(), std::back_inserter(values), [&idx](const auto &asset) { return asset->historic.idx_value(idx); });
-    return static_cast<double>(std::accumulate(values.begin(), values.end(), 0.0f));
+    refresh_historic(idx);
+    return idx_values[idx];
 }
 
 auto Portfolio::idx_total_weight(const size_t &idx) const noexcept -> double
 {
-    std::vector<double> weights;
-    double pv(idx_total_value(idx));
-    std::transform(assets.begin(), assets.end(), std::back_inserter(weights), [&idx, &pv](const auto &asset) { return asset->historic.idx_value(idx) / pv; });
-    return static_cast<double>(std::accumulate(weights.begin(), weights.end(), 0.0f));
+    refresh_historic(idx);
+    return idx_weights[idx];
+}
+
+auto Portfolio::idx_weight(const size_t &asset, const size_t &idx) const noexcept -> double
+{
+    return assets[asset]->historic.idx_value(idx) / idx_total_value(idx);
 }
 
 auto Portfolio::idx_list_quantities(const size_t &idx) const noexcept -> const std::vector<double>
@@ -64,19 +73,31 @@ auto Portfolio::idx_list_prices(const size_t &idx) const noexcept -> const std::
     return result;
 }
 
+void Portfolio::idx_fill_quantities(const size_t &idx, std::vector<double> &result) const noexcept
+{
+    std::transform(assets.begin(), assets.end(), result.begin(), [&idx](const auto &asset) { return asset->historic.idx_quantity(idx); });
+}
+
+void Portfolio::idx_fill_prices(const size_t &idx, std::vector<double> &result) const noexcept
+{
+    std::transform(assets.begin(), assets.end(), result.begin(), [&idx](const auto &asset) { return asset->historic.idx_price(idx); });
+}
+
 auto Portfolio::current_total_value(const size_t &which) const noexcept -> double
 {
-    std::vector<double> values;
-    std::transform(assets.begin(), assets.end(), std::back_inserter(values), [&which](const auto &asset) { return asset->current[which].value(); });
-    return static_cast<double>(std::accumulate(values.begin(), values.end(), 0.0f));
+    refresh_current(which);
+    return current_values[which];
 }
 
 auto Portfolio::current_total_weight(const size_t &which) const noexcept -> double
 {
-    std::vector<double> weights;
-    double pv(current_total_value(which));
-    std::transform(assets.begin(), assets.end(), std::back_inserter(weights), [&which, &pv](const auto &asset) { return asset->current[which].value() / pv; });
-    return static_cast<double>(std::accumulate(weights.begin(), weights.end(), 0.0f));
+    refresh_current(which);
+    return current_weights[which];
+}
+
+auto Portfolio::current_weight(const size_t &asset, const size_t &which) const noexcept -> double
+{
+    return assets[asset]->current[which].value() / current_total_value(which);
 }
 
 auto Portfolio::current_list_quantities(const size_t &which) const noexcept -> const std::vector<double>
@@ -93,6 +114,16 @@ auto Portfolio::current_list_prices(const size_t &which) const noexcept -> const
     return result;
 }
 
+void Portfolio::current_fill_quantities(const size_t &which, std::vector<double> &result) const noexcept
+{
+    std::transform(assets.begin(), assets.end(), result.begin(), [&which](const auto &asset) { return asset->current[which].quantity; });
+}
+
+void Portfolio::current_fill_prices(const size_t &which, std::vector<double> &result) const noexcept
+{
+    std::transform(assets.begin(), assets.end(), result.begin(), [&which](const auto &asset) { return asset->current[which].price; });
+}
+
 auto Portfolio::current_output_state(const size_t &which) const noexcept -> const std::stringstream
 {
     std::stringstream result;
@@ -104,9 +135,10 @@ auto Portfolio::current_output_state(const size_t &which) const noexcept -> cons
     result << "   Tot. weight: " << num2str(100.0 * current_total_weight(which));
     result << std::endl;
 
+    double pv(current_total_value(which));
     for (auto const &asset : assets)
     {
-        result << asset->current_output_state(current_total_value(which), which).str();
+        result << asset->current_output_state(pv, which).str();
     }
 
     return result;
@@ -146,31 +178,31 @@ auto Portfolio::current_output_performance(const size_t &before, const size_t &a
     return result;
 }
 
-auto Portfolio::history_output(const size_t &before, const size_t &after) const noexcept -> const std::stringstream
+void Portfolio::history_output(Report &report, const size_t &before, const size_t &after) const noexcept
 {
-    std::stringstream result;
-    
-    result << "..................................................................................................................." << std::endl;
-    result << "Output of portfolio historic timeseries from " << std::to_string(before) << " to " << std::to_string(after - 1) << std::endl;
-    result << "..................................................................................................................." << std::endl;
+    const std::string rule("...................................................................................................................");
+
+    report.text(rule).line();
+    report.text("Output of portfolio historic timeseries from ").integer(before).text(" to ").integer(after - 1).line();
+    report.text(rule).line();
     for (size_t ti(before); ti < after; ti++)
     {
         double pv(idx_total_value(ti));
 
-        result << "Time: " << time2str(idx_time(ti));
-        result << " at vector element: " << std::to_string(ti) << std::endl;
-        result << "           Tot. value: " << num2str(idx_total_value(ti));
-        result << "   Tot. weight: " << num2str(100.0 * idx_total_weight(ti));
-        result << std::endl;
+        report.text("Time: ").time(idx_time(ti));
+        report.text(" at vector element: ").integer(ti).line();
+        report.text("           Tot. value: ").number(pv);
+        report.text("   Tot. weight: ").number(100.0 * idx_total_weight(ti));
+        report.line();
 
         for (auto const &asset : assets)
         {
-            result << asset->get_name();
-            result << "   With value: " << num2str(asset->historic.idx_value(ti));
-            result << "   With weight: " << num2str(100.0 * asset->historic.idx_value(ti) / pv);
-            result << "   With quantity: " << num2str(asset->historic.idx_quantity(ti));
-            result << "   With price: " << num2str(asset->historic.idx_price(ti));
-            result << std::endl;
+            report.text(asset->get_name());
+            report.text("   With value: ").number(asset->historic.idx_value(ti));
+            report.text("   With weight: ").number(100.0 * asset->historic.idx_value(ti) / pv);
+            report.text("   With quantity: ").number(asset->historic.idx_quantity(ti));
+            report.text("   With price: ").number(asset->historic.idx_price(ti));
+            report.line();
         }
     }
 
@@ -182,15 +214,61 @@ auto Portfolio::history_output(const size_t &before, const size_t &after) const
     double delta_t((time2 - time1) / (365.25 * 24.0 * 60.0 * 60.0 / 12.0));
     double perf(pow(pv2 / pv1, 1.0 / delta_t));
 
-    result << "..................................................................................................................." << std::endl;
-    result << "Performance total:    " << num2str((pv2 / pv1 - 1.0) * 100.0) << " %" << std::endl;
-    result << "Performance monthly:  " << num2str((perf - 1.0) * 100.0) << " %" << std::endl;
-    result << "PV before:              " << num2str(pv1) << std::endl;
-    result << "PV after:               " << num2str(pv2) << std::endl;
-    result << "PV change:              " << num2str(pv2 - pv1) << std::endl;
-    result << "Time before: " << time2str(idx_time(before)) << std::endl;
-    result << "Time after:  " << time2str(idx_time(after)) << std::endl;
-    result << "..................................................................................................................." << std::endl;
+    report.text(rule).line();
+    report.text("Performance total:    ").number((pv2 / pv1 - 1.0) * 100.0).text(" %").line();
+    report.text("Performance monthly:  ").number((perf - 1.0) * 100.0).text(" %").line();
+    report.text("PV before:              ").number(pv1).line();
+    report.text("PV after:               ").number(pv2).line();
+    report.text("PV change:              ").number(pv2 - pv1).line();
+    report.text("Time before: ").time(idx_time(before)).line();
+    report.text("Time after:  ").time(idx_time(after)).line();
+    report.text(rule).line();
+    report.flush();
+}
 
-    return result;
+void Portfolio::refresh_historic(const size_t &idx) const noexcept
+{
+    if (idx < marks->historic_from)
+    {
+        return;
+    }
+
+    idx_values.resize(number_timebins(), 0.0);
+    idx_weights.resize(number_timebins(), 0.0);
+    for (size_t ti(marks->historic_from); ti <= idx; ti++)
+    {
+        double pv(0.0), weight(0.0);
+        for (auto const &asset : assets)
+        {
+            pv += asset->historic.idx_value(ti);
+        }
+        for (auto const &asset : assets)
+        {
+            weight += asset->historic.idx_value(ti) / pv;
+        }
+        idx_values[ti] = pv;
+        idx_weights[ti] = weight;
+    }
+    marks->historic_from = idx + 1;
+}
+
+void Portfolio::refresh_current(const size_t &which) const noexcept
+{
+    if (!marks->current[which])
+    {
+        return;
+    }
+
+    double pv(0.0), weight(0.0);
+    for (auto const &asset : assets)
+    {
+        pv += asset->current[which].value();
+    }
+    for (auto const &asset : assets)
+    {
+        weight += asset->current[which].value() / pv;
+    }
+    current_values[which] = pv;
+    current_weights[which] = weight;
+    marks->current[which] = false;
 }
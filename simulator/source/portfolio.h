@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "asset.h"
 #include "config.h"
+#include "report.h"
 #include "utils.h"
 
 // Class for storing, accessing and manipulating several cryptocurrencies in a portfolio
@@ -44,6 +45,8 @@ public:
     [[nodiscard]] auto idx_total_value(const size_t &idx) const noexcept -> double;
     // Read out sum of historic portfolio weights at element idx - consistency check
     [[nodiscard]] auto idx_total_weight(const size_t &idx) const noexcept -> double;
+    // Read out historic portfolio weight of one asset at element idx
+    [[nodiscard]] auto idx_weight(const size_t &asset, const size_t &idx) const noexcept -> double;
     // Read of historic time at elemend idx
     [[nodiscard]] auto idx_time(const size_t &idx) const noexcept -> long { return assets[0]->historic.idx_time(idx); }
 
@@ -51,11 +54,16 @@ public:
     [[nodiscard]] auto idx_list_quantities(const size_t &idx) const noexcept -> const std::vector<double>;
     // Read out vector of historic asset prices at element idx
     [[nodiscard]] auto idx_list_prices(const size_t &idx) const noexcept -> const std::vector<double>;
+    // Fill existing vector (sized to number of assets) with historic asset quantities or prices at element idx
+    void idx_fill_quantities(const size_t &idx, std::vector<double> &result) const noexcept;
+    void idx_fill_prices(const size_t &idx, std::vector<double> &result) const noexcept;
 
     // Read out total portfolio value of current one-time ticker information element "which"
     [[nodiscard]] auto current_total_value(const size_t &which) const noexcept -> double;
     // Read out total weight of current one-time ticker information element "which" - consistency check
     [[nodiscard]] auto current_total_weight(const size_t &which) const noexcept -> double;
+    // Read out portfolio weight of one asset of current one-time ticker information element "which"
+    [[nodiscard]] auto current_weight(const size_t &asset, const size_t &which) const noexcept -> double;
     // Read out time of current one-time ticker information element "which"
     [[nodiscard]] auto current_time(const size_t &which) const noexcept -> long { return assets[0]->current[which].time; }
 
@@ -63,6 +71,9 @@ public:
     [[nodiscard]] auto current_list_quantities(const size_t &which) const noexcept -> const std::vector<double>;
     // Read out vector of current one-time ticker information asset prices at element "which"
     [[nodiscard]] auto current_list_prices(const size_t &which) const noexcept -> const std::vector<double>;
+    // Fill existing vector (sized to number of assets) with current asset quantities or prices at element "which"
+    void current_fill_quantities(const size_t &which, std::vector<double> &result) const noexcept;
+    void current_fill_prices(const size_t &which, std::vector<double> &result) const noexcept;
 
     // Read out number of asses in portfolio
     [[nodiscard]] auto number_assets() const noexcept -> size_t { return assets.size(); }
@@ -76,13 +87,26 @@ public:
     // Prints to the console the performance in one-time ticker information between "before" and "after"
     [[nodiscard]] auto current_output_performance(const size_t &before, const size_t &after) const noexcept -> const std::stringstream;
 
-    // Prints to the console the entire timeseries of historic data including performance
-    [[nodiscard]] auto history_output(const size_t &before, const size_t &after) const noexcept -> const std::stringstream;
+    // Renders into "report" the entire timeseries of historic data including performance
+    void history_output(Report &report, const size_t &before, const size_t &after) const noexcept;
 
     // Vector storing pointers to the individual assets
     std::vector<std::unique_ptr<Asset>> assets;
 
 private:
+    // Marks of outdated aggregates - shared with all assets and set by their setters
+    std::shared_ptr<DirtyMarks> marks;
+
+    // Cached portfolio values and weight sums per historic timebin and per current element
+    // Recalculated on read only where marked outdated - reading is not thread-safe
+    mutable std::vector<double> idx_values;
+    mutable std::vector<double> idx_weights;
+    mutable std::vector<double> current_values;
+    mutable std::vector<double> current_weights;
+
+    // Recalculate outdated historic aggregates up to element idx and outdated aggregates of current element "which"
+    void refresh_historic(const size_t &idx) const noexcept;
+    void refresh_current(const size_t &which) const noexcept;
 };
 
 #endif
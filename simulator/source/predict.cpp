@@ -18,13 +18,36 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "predict.h"
 
-auto Optimizer::predict_weights() noexcept -> const std::vector<double>
+auto make_optimizer(const std::string &strategy, std::shared_ptr<Portfolio> portfolio) noexcept -> std::unique_ptr<Optimizer>
 {
     // INVOKE POINT FOR DEEP REINFORCEMENT LEARNING ALGORITHM
     // MOVE DATA INTO NEURAL NETWORK
     // TRAIN AGENT ON RETURNS AND REWARDS
     // PREDICT PORTFOLIO WEIGHTS
 
-    //std::cout << "Optimizer predict_weights() executed." << std::endl;
-    return std::vector<double>(P->number_assets(), 0.0);
+    // Registry of all strategies - each entry creates an optimizer compiled for exactly this strategy
+    using Factory = std::function<std::unique_ptr<Optimizer>(std::shared_ptr<Portfolio>)>;
+    static const std::map<std::string, Factory> registry{
+        {"deinvest", [](std::shared_ptr<Portfolio> p) -> std::unique_ptr<Optimizer> {
+             size_t assets(p->number_assets());
+             return std::make_unique<StrategyOptimizer<Deinvest>>(std::move(p), assets);
+         }},
+        {"equal", [](std::shared_ptr<Portfolio> p) -> std::unique_ptr<Optimizer> {
+             size_t assets(p->number_assets());
+             return std::make_unique<StrategyOptimizer<EqualWeight>>(std::move(p), assets);
+         }},
+        {"hrp", [](std::shared_ptr<Portfolio> p) -> std::unique_ptr<Optimizer> {
+             size_t assets(p->number_assets());
+             return std::make_unique<StrategyOptimizer<RiskParity>>(std::move(p), assets, static_cast<size_t>(CF.hrp_lookback), CF.hrp_tolerance);
+         }}};
+
+    auto entry(registry.find(strategy));
+    if (entry == registry.end())
+    {
+        LOG.warning("Unknown strategy - using default strategy", {{"strategy", strategy}, {"default", default_strategy}});
+        entry = registry.find(default_strategy);
+    }
+
+    LOG.info("make_optimizer() executed", {{"strategy", entry->first}});
+    return entry->second(std::move(portfolio));
 }
@@ -20,10 +20,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define PREDICT_H
 
 #include "optimizer.h"
+#include "riskparity.h"
+#include "strategy.h"
 
 // INVOKE POINT FOR DEEP REINFORCEMENT LEARNING ALGORITHM
 // MOVE DATA INTO NEURAL NETWORK
 // TRAIN AGENT ON RETURNS AND REWARDS
 // PREDICT PORTFOLIO WEIGHTS
 
+// Strategy used if the configuration file names an unknown strategy
+inline const std::string default_strategy{"hrp"};
+
+// Create an optimizer specialised for the strategy with given name (see STRATEGY in configuration file)
+auto make_optimizer(const std::string &strategy, std::shared_ptr<Portfolio> portfolio) noexcept -> std::unique_ptr<Optimizer>;
+
 #endif
@@ -0,0 +1,93 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "utils.h"
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread
+// Capacity is rounded up to a power of two - head and tail live on separate cache lines
+template <typename T>
+class SpscQueue
+{
+public:
+    // Constructor - takes minimum number of elements the queue can hold
+    explicit SpscQueue(const size_t &capacity) noexcept
+    {
+        size_t size(2);
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        buffer = std::vector<T>(size);
+        mask = size - 1;
+    }
+
+    // Append element - returns false without blocking if the queue is full (producer thread only)
+    [[nodiscard]] auto try_push(const T &element) noexcept -> bool
+    {
+        size_t tail_now(tail.load(std::memory_order_relaxed));
+        if (tail_now - head.load(std::memory_order_acquire) > mask)
+        {
+            return false;
+        }
+        buffer[tail_now & mask] = element;
+        tail.store(tail_now + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Append element by moving it - leaves "element" untouched if the queue is full (producer thread only)
+    [[nodiscard]] auto try_push(T &&element) noexcept -> bool
+    {
+        size_t tail_now(tail.load(std::memory_order_relaxed));
+        if (tail_now - head.load(std::memory_order_acquire) > mask)
+        {
+            return false;
+        }
+        buffer[tail_now & mask] = std::move(element);
+        tail.store(tail_now + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Remove oldest element - returns false without blocking if the queue is empty (consumer thread only)
+    [[nodiscard]] auto try_pop(T &element) noexcept -> bool
+    {
+        size_t head_now(head.load(std::memory_order_relaxed));
+        if (head_now == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        element = std::move(buffer[head_now & mask]);
+        head.store(head_now + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Check whether the queue is empty or full - exact on the consuming or producing side, a snapshot on any other thread
+    [[nodiscard]] auto empty() const noexcept -> bool { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    [[nodiscard]] auto full() const noexcept -> bool { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) > mask; }
+
+private:
+    std::vector<T> buffer;
+    size_t mask{0};
+
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "report.h"
+
+Report::Report() noexcept
+{
+    borrow();
+}
+
+Report::~Report() noexcept
+{
+    if (used > 0)
+    {
+        buffer.resize(used);
+        LOG.text(std::move(buffer));
+    }
+    else
+    {
+        LOG.return_block(std::move(buffer));
+    }
+}
+
+auto Report::text(std::string_view data) noexcept -> Report &
+{
+    for (size_t offset(0); offset < data.size();)
+    {
+        ensure(1);
+        size_t length(std::min(data.size() - offset, capacity - used));
+        std::copy(data.begin() + static_cast<long>(offset), data.begin() + static_cast<long>(offset + length), buffer.begin() + static_cast<long>(used));
+        used += length;
+        offset += length;
+    }
+    return *this;
+}
+
+auto Report::number(const double &data) noexcept -> Report &
+{
+    ensure(reserve);
+    used = static_cast<size_t>(num2chars(buffer.data() + used, buffer.data() + capacity, data) - buffer.data());
+    return *this;
+}
+
+auto Report::integer(const size_t &data) noexcept -> Report &
+{
+    ensure(reserve);
+    used = static_cast<size_t>(std::to_chars(buffer.data() + used, buffer.data() + capacity, data).ptr - buffer.data());
+    return *this;
+}
+
+auto Report::time(const long &data) noexcept -> Report &
+{
+    ensure(reserve);
+    time_t ut(data);
+    struct tm local;
+    localtime_r(&ut, &local);
+    used += std::strftime(buffer.data() + used, capacity - used, "%F - %T", &local);
+    return *this;
+}
+
+auto Report::line() noexcept -> Report &
+{
+    ensure(1);
+    buffer[used++] = '\n';
+    return *this;
+}
+
+void Report::flush() noexcept
+{
+    if (used > 0)
+    {
+        // Buffer itself is handed over - the logger returns it to its pool once written out
+        buffer.resize(used);
+        LOG.text(std::move(buffer));
+        borrow();
+    }
+    used = 0;
+}
+
+void Report::borrow() noexcept
+{
+    buffer = LOG.borrow_block();
+    buffer.resize(capacity);
+    used = 0;
+}
+
+void Report::ensure(const size_t &size) noexcept
+{
+    if (capacity - used < size)
+    {
+        flush();
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for rendering large text reports into the logger
+// Formats without allocating into a buffer borrowed from the pool of the logger - handed over whenever it fills up
+// The logger writes the buffer out and puts it back into its pool, so reports allocate only until the pool is warm
+class Report
+{
+public:
+    // Constructor - borrows a buffer from the logger
+    explicit Report() noexcept;
+    // Destructor - hands over remaining output and returns the unused buffer
+    ~Report() noexcept;
+    // Dummies to comply with Rule of Five
+    Report(const Report &source) = delete;
+    Report(Report &&source) = delete;
+    auto operator=(const Report &source) -> Report & = delete;
+    auto operator=(Report &&source) -> Report & = delete;
+
+    // Append text, a number formatted as num2str, an integer, a unix time formatted as time2str or a line break
+    auto text(std::string_view data) noexcept -> Report &;
+    auto number(const double &data) noexcept -> Report &;
+    auto integer(const size_t &data) noexcept -> Report &;
+    auto time(const long &data) noexcept -> Report &;
+    auto line() noexcept -> Report &;
+
+    // Hand over buffer to the logger - written after all entries logged before by the same thread
+    void flush() noexcept;
+
+private:
+    // Size of buffer and space kept free for formatting a single element
+    static constexpr size_t capacity{Logger::block_capacity};
+    static constexpr size_t reserve{512};
+
+    // Sized to capacity - characters beyond "used" are scratch
+    std::string buffer;
+    size_t used{0};
+
+    // Borrow the next buffer from the logger
+    void borrow() noexcept;
+    // Hand over buffer if less than "size" characters are free
+    void ensure(const size_t &size) noexcept;
+};
+
+#endif
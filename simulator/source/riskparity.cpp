@@ -0,0 +1,260 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "riskparity.h"
+
+// Lower bound for variances to keep inverse-variance weights finite
+static constexpr double min_variance{1.0e-12};
+
+RiskParity::RiskParity(const size_t &assets, const size_t &lookback, const double &tolerance) noexcept
+    : n(assets - 1), lookback(lookback), tolerance(tolerance)
+{
+    covariance = std::vector<double>(n * n, 0.0);
+    correlation = std::vector<double>(n * n, 0.0);
+    clustered_correlation = std::vector<double>(n * n, 0.0);
+    linkage = std::vector<double>(n * n, 0.0);
+    mean = std::vector<double>(n, 0.0);
+
+    head = std::vector<size_t>(n, 0);
+    tail = std::vector<size_t>(n, 0);
+    next = std::vector<size_t>(n, 0);
+    active = std::vector<bool>(n, false);
+    order = std::vector<size_t>(n, 0);
+    std::iota(order.begin(), order.end(), 0);
+
+    LOG.info("RiskParity constructor executed", {{"assets", n}});
+}
+
+RiskParity::~RiskParity() noexcept
+{
+    LOG.info("RiskParity destructor executed", {{"clusterings", clusterings}, {"reuses", reuses}});
+}
+
+void RiskParity::reset() noexcept
+{
+    clustered = false;
+    std::iota(order.begin(), order.end(), 0);
+}
+
+void RiskParity::calculate_weights(double **returns, const size_t &ti, std::vector<double> &weights) noexcept
+{
+    std::fill(weights.begin(), weights.end(), 0.0);
+    if (n == 0)
+    {
+        return;
+    }
+
+    // Returns at timebin 0 are undefined, the window always starts at timebin 1 or later
+    size_t begin(ti + 1 > lookback ? ti + 1 - lookback : 1);
+
+    // Not enough history for a covariance estimate - fall back to equal weights
+    if (ti < begin + 1)
+    {
+        std::fill(weights.begin() + 1, weights.end(), 1.0 / static_cast<double>(n));
+        return;
+    }
+
+    calculate_covariance(returns, begin, ti);
+
+    // Reuse the quasi-diagonal order while the correlation structure stays within tolerance
+    if (!clustered || correlation_changed())
+    {
+        calculate_clusters();
+        clusterings++;
+    }
+    else
+    {
+        reuses++;
+    }
+
+    bisect(0, n, 1.0, weights);
+}
+
+void RiskParity::calculate_covariance(double **returns, const size_t &begin, const size_t &end) noexcept
+{
+    auto samples(static_cast<double>(end - begin + 1));
+
+    for (size_t ii(0); ii < n; ii++)
+    {
+        double sum(0.0);
+        for (size_t ti(begin); ti <= end; ti++)
+        {
+            // Column 0 holds the riskfree asset
+            sum += returns[ti][ii + 1];
+        }
+        mean[ii] = sum / samples;
+    }
+
+    for (size_t ii(0); ii < n; ii++)
+    {
+        for (size_t jj(ii); jj < n; jj++)
+        {
+            double sum(0.0);
+            for (size_t ti(begin); ti <= end; ti++)
+            {
+                sum += (returns[ti][ii + 1] - mean[ii]) * (returns[ti][jj + 1] - mean[jj]);
+            }
+            covariance[ii * n + jj] = sum / (samples - 1.0);
+            covariance[jj * n + ii] = covariance[ii * n + jj];
+        }
+    }
+
+    for (size_t ii(0); ii < n; ii++)
+    {
+        for (size_t jj(0); jj < n; jj++)
+        {
+            double vi(covariance[ii * n + ii]);
+            double vj(covariance[jj * n + jj]);
+            if (ii == jj)
+            {
+                correlation[ii * n + jj] = 1.0;
+            }
+            else if (vi > min_variance && vj > min_variance)
+            {
+                correlation[ii * n + jj] = covariance[ii * n + jj] / sqrt(vi * vj);
+            }
+            else
+            {
+                correlation[ii * n + jj] = 0.0;
+            }
+        }
+    }
+}
+
+auto RiskParity::correlation_changed() const noexcept -> bool
+{
+    for (size_t ij(0); ij < n * n; ij++)
+    {
+        if (fabs(correlation[ij] - clustered_correlation[ij]) > tolerance)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RiskParity::calculate_clusters() noexcept
+{
+    // Correlation distance between single assets
+    for (size_t ij(0); ij < n * n; ij++)
+    {
+        linkage[ij] = sqrt(std::max(0.0, 0.5 * (1.0 - correlation[ij])));
+    }
+
+    // Every asset starts as its own cluster
+    for (size_t ii(0); ii < n; ii++)
+    {
+        head[ii] = ii;
+        tail[ii] = ii;
+        next[ii] = n;
+        active[ii] = true;
+    }
+
+    // Merge the two closest clusters until only one is left
+    for (size_t merge(1); merge < n; merge++)
+    {
+        size_t first(0), second(0);
+        double closest(std::numeric_limits<double>::max());
+        for (size_t ii(0); ii < n; ii++)
+        {
+            for (size_t jj(ii + 1); jj < n && active[ii]; jj++)
+            {
+                if (active[jj] && linkage[ii * n + jj] < closest)
+                {
+                    closest = linkage[ii * n + jj];
+                    first = ii;
+                    second = jj;
+                }
+            }
+        }
+
+        // Append members of second cluster behind members of first cluster
+        next[tail[first]] = head[second];
+        tail[first] = tail[second];
+        active[second] = false;
+
+        // Single linkage - distance to merged cluster is the minimum of both distances
+        for (size_t kk(0); kk < n; kk++)
+        {
+            if (active[kk] && kk != first)
+            {
+                double distance(std::min(linkage[first * n + kk], linkage[second * n + kk]));
+                linkage[first * n + kk] = distance;
+                linkage[kk * n + first] = distance;
+            }
+        }
+    }
+
+    // Walk along the remaining cluster to obtain the quasi-diagonal order
+    size_t root(static_cast<size_t>(std::distance(active.begin(), std::find(active.begin(), active.end(), true))));
+    size_t position(0);
+    for (size_t asset(head[root]); asset < n; asset = next[asset])
+    {
+        order[position++] = asset;
+    }
+
+    std::copy(correlation.begin(), correlation.end(), clustered_correlation.begin());
+    clustered = true;
+}
+
+auto RiskParity::cluster_variance(const size_t &begin, const size_t &end) const noexcept -> double
+{
+    // Inverse-variance weights inside the cluster
+    double norm(0.0);
+    for (size_t ii(begin); ii < end; ii++)
+    {
+        norm += 1.0 / std::max(covariance[order[ii] * n + order[ii]], min_variance);
+    }
+
+    double variance(0.0);
+    for (size_t ii(begin); ii < end; ii++)
+    {
+        double wi(1.0 / std::max(covariance[order[ii] * n + order[ii]], min_variance) / norm);
+        for (size_t jj(begin); jj < end; jj++)
+        {
+            double wj(1.0 / std::max(covariance[order[jj] * n + order[jj]], min_variance) / norm);
+            variance += wi * wj * covariance[order[ii] * n + order[jj]];
+        }
+    }
+
+    return variance;
+}
+
+void RiskParity::bisect(const size_t &begin, const size_t &end, const double &allocation, std::vector<double> &weights) const noexcept
+{
+    if (end - begin == 1)
+    {
+        // Column 0 holds the riskfree asset
+        weights[order[begin] + 1] = allocation;
+        return;
+    }
+
+    size_t middle(begin + (end - begin) / 2);
+    double variance_left(cluster_variance(begin, middle));
+    double variance_right(cluster_variance(middle, end));
+
+    // Split allocation inversely proportional to cluster variances
+    double alpha(0.5);
+    if (variance_left + variance_right > min_variance)
+    {
+        alpha = 1.0 - variance_left / (variance_left + variance_right);
+    }
+
+    bisect(begin, middle, allocation * alpha, weights);
+    bisect(middle, end, allocation * (1.0 - alpha), weights);
+}
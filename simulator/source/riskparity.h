@@ -0,0 +1,93 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RISKPARITY_H
+#define RISKPARITY_H
+
+#include "config.h"
+#include "strategy.h"
+#include "utils.h"
+
+// Class for calculating portfolio weights with Hierarchical Risk Parity (HRP)
+// Clusters the correlation matrix of the returns (single linkage) and allocates by recursive bisection
+// All work buffers are sized once in the constructor - no allocations when calculating weights
+class RiskParity : public Strategy<RiskParity>
+{
+public:
+    // Constructor - takes number of assets (including riskfree), lookback window in timebins and correlation tolerance
+    explicit RiskParity(const size_t &assets, const size_t &lookback, const double &tolerance) noexcept;
+    // Destructor - cleans up
+    ~RiskParity() noexcept;
+    // Copyable - optimizers copy a pristine instance wherever a run must start from a clean state
+    RiskParity(const RiskParity &source) = default;
+    RiskParity(RiskParity &&source) = default;
+    auto operator=(const RiskParity &source) -> RiskParity & = delete;
+    auto operator=(RiskParity &&source) -> RiskParity & = delete;
+
+    // Calculate weights of all assets from the returns of the lookback window ending at timebin ti
+    // Riskfree asset always receives zero weight, all other weights sum up to one
+    void calculate_weights(double **returns, const size_t &ti, std::vector<double> &weights) noexcept;
+
+    // Forget the clustering of earlier timebins - the next call of calculate_weights() clusters again
+    void reset() noexcept;
+
+    // Read out how often the clustering was (re-)calculated and how often it was reused
+    [[nodiscard]] auto number_clusterings() const noexcept -> size_t { return clusterings; }
+    [[nodiscard]] auto number_reuses() const noexcept -> size_t { return reuses; }
+
+private:
+    // Number of non-riskfree assets, lookback window and maximum correlation change before reclustering
+    size_t n;
+    size_t lookback;
+    double tolerance;
+
+    // Covariance and correlation matrices of non-riskfree assets (n x n, row-major)
+    std::vector<double> covariance;
+    std::vector<double> correlation;
+    // Correlation matrix at the time of the last clustering
+    std::vector<double> clustered_correlation;
+    // Single linkage distances between clusters during clustering (n x n, row-major)
+    std::vector<double> linkage;
+    // Mean of returns in lookback window
+    std::vector<double> mean;
+
+    // Clusters are kept as linked lists of assets, merged lists give the quasi-diagonal order
+    std::vector<size_t> head;
+    std::vector<size_t> tail;
+    std::vector<size_t> next;
+    std::vector<bool> active;
+    // Quasi-diagonal order of assets after clustering
+    std::vector<size_t> order;
+
+    bool clustered{false};
+    size_t clusterings{0};
+    size_t reuses{0};
+
+    // Calculate covariance and correlation of the returns between timebins "begin" and "end" (inclusive)
+    void calculate_covariance(double **returns, const size_t &begin, const size_t &end) noexcept;
+    // Check if correlation structure moved more than tolerance since last clustering
+    [[nodiscard]] auto correlation_changed() const noexcept -> bool;
+    // Single linkage clustering on correlation distances - fills quasi-diagonal order
+    void calculate_clusters() noexcept;
+    // Variance of inverse-variance weighted cluster of ordered assets between "begin" and "end" (exclusive)
+    [[nodiscard]] auto cluster_variance(const size_t &begin, const size_t &end) const noexcept -> double;
+    // Recursive bisection splitting "allocation" between ordered assets "begin" and "end" (exclusive)
+    void bisect(const size_t &begin, const size_t &end, const double &allocation, std::vector<double> &weights) const noexcept;
+};
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "scenario.h"
+
+Scenario::Scenario(double **returns, const size_t &timebins, const size_t &assets, const std::string &method, const size_t &block) noexcept
+    : returns(returns), timebins(timebins), assets(assets), block(std::max(block, static_cast<size_t>(1))), bootstrap(method != "gbm")
+{
+    mean = std::vector<double>(assets, 0.0);
+    cholesky = std::vector<double>(assets * assets, 0.0);
+
+    if (!bootstrap && timebins > 2)
+    {
+        auto samples(static_cast<double>(timebins - 1));
+        std::vector<double> covariance(assets * assets, 0.0);
+
+        for (size_t ii(0); ii < assets; ii++)
+        {
+            for (size_t ti(1); ti < timebins; ti++)
+            {
+                mean[ii] += returns[ti][ii] / samples;
+            }
+        }
+
+        for (size_t ii(0); ii < assets; ii++)
+        {
+            for (size_t jj(0); jj <= ii; jj++)
+            {
+                double sum(0.0);
+                for (size_t ti(1); ti < timebins; ti++)
+                {
+                    sum += (returns[ti][ii] - mean[ii]) * (returns[ti][jj] - mean[jj]);
+                }
+                covariance[ii * assets + jj] = sum / (samples - 1.0);
+                covariance[jj * assets + ii] = covariance[ii * assets + jj];
+            }
+        }
+
+        // Cholesky decomposition - assets without variance (riskfree) keep a zero row
+        for (size_t ii(0); ii < assets; ii++)
+        {
+            for (size_t jj(0); jj <= ii; jj++)
+            {
+                double sum(covariance[ii * assets + jj]);
+                for (size_t kk(0); kk < jj; kk++)
+                {
+                    sum -= cholesky[ii * assets + kk] * cholesky[jj * assets + kk];
+                }
+                if (ii == jj)
+                {
+                    cholesky[ii * assets + ii] = sum > 0.0 ? sqrt(sum) : 0.0;
+                }
+                else if (cholesky[jj * assets + jj] > 0.0)
+                {
+                    cholesky[ii * assets + jj] = sum / cholesky[jj * assets + jj];
+                }
+            }
+        }
+    }
+
+    LOG.info("Scenario constructor executed", {{"method", get_method()}});
+}
+
+void Scenario::generate(const unsigned long &seed, const size_t &length, double **path) const noexcept
+{
+    std::mt19937_64 generator(seed);
+    std::fill(path[0], path[0] + assets, 0.0);
+
+    if (timebins < 2)
+    {
+        // No historic returns to sample from
+        for (size_t ti(1); ti <= length; ti++)
+        {
+            std::fill(path[ti], path[ti] + assets, 0.0);
+        }
+    }
+    else if (bootstrap)
+    {
+        // Copy whole rows to keep the cross-sectional correlation of the assets
+        std::uniform_int_distribution<size_t> start(1, timebins > block ? timebins - block : 1);
+        for (size_t ti(1); ti <= length;)
+        {
+            size_t from(start(generator));
+            for (size_t bi(0); bi < block && ti <= length && from + bi < timebins; bi++, ti++)
+            {
+                std::copy(returns[from + bi], returns[from + bi] + assets, path[ti]);
+            }
+        }
+    }
+    else
+    {
+        std::normal_distribution<double> normal(0.0, 1.0);
+        for (size_t ti(1); ti <= length; ti++)
+        {
+            // Draw independent normals into the row first, then correlate in place from the last asset backwards
+            for (size_t ii(0); ii < assets; ii++)
+            {
+                path[ti][ii] = normal(generator);
+            }
+            for (size_t ii(assets); ii-- > 0;)
+            {
+                double value(mean[ii]);
+                for (size_t kk(0); kk <= ii; kk++)
+                {
+                    value += cholesky[ii * assets + kk] * path[ti][kk];
+                }
+                path[ti][ii] = value;
+            }
+        }
+    }
+}
+
+auto ScenarioResult::output() const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+
+    // Percentile of a distribution - takes a copy to sort
+    auto percentile = [](std::vector<double> values, const double &fraction) {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        auto position(static_cast<size_t>(fraction * static_cast<double>(values.size() - 1)));
+        std::nth_element(values.begin(), values.begin() + static_cast<long>(position), values.end());
+        return values[position];
+    };
+
+    const std::vector<double> fractions{0.05, 0.25, 0.50, 0.75, 0.95};
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Monte Carlo scenarios over " << std::to_string(final_value.size()) << " paths" << std::endl;
+    result << "Percentile:               ";
+    for (auto const &fraction : fractions)
+    {
+        result << "     " << std::setw(3) << static_cast<int>(100.0 * fraction) << "% ";
+    }
+    result << std::endl;
+
+    result << "Performance (%):          ";
+    for (auto const &fraction : fractions)
+    {
+        result << num2str(100.0 * (percentile(final_value, fraction) - 1.0));
+    }
+    result << std::endl;
+
+    result << "Max drawdown (%):         ";
+    for (auto const &fraction : fractions)
+    {
+        result << num2str(100.0 * percentile(drawdown, fraction));
+    }
+    result << std::endl;
+
+    result << "Turnover:                 ";
+    for (auto const &fraction : fractions)
+    {
+        result << num2str(percentile(turnover, fraction));
+    }
+    result << std::endl;
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
@@ -0,0 +1,65 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for generating synthetic return paths from historic returns
+// Either block bootstrap of historic timebins or correlated geometric brownian motion fitted to the history
+class Scenario
+{
+public:
+    // Constructor - takes historic returns (timebins x assets), method ("bootstrap" or "gbm") and bootstrap block length
+    explicit Scenario(double **returns, const size_t &timebins, const size_t &assets, const std::string &method, const size_t &block) noexcept;
+
+    // Fill rows 1 to "length" of "path" with synthetic returns, row 0 with zeros
+    // Same seed always gives the same path - independent of the thread generating it
+    void generate(const unsigned long &seed, const size_t &length, double **path) const noexcept;
+
+    // Read out name of method used for generating paths
+    [[nodiscard]] auto get_method() const noexcept -> const std::string { return bootstrap ? "bootstrap" : "gbm"; }
+
+private:
+    // Historic returns - row 0 is undefined and never sampled
+    double **returns;
+    size_t timebins;
+    size_t assets;
+    size_t block;
+    bool bootstrap;
+
+    // Mean vector and lower Cholesky factor (assets x assets, row-major) of the historic returns for gbm
+    std::vector<double> mean;
+    std::vector<double> cholesky;
+};
+
+// Struct for storing the distribution of results over all synthetic paths
+struct ScenarioResult
+{
+    // One entry per path - relative final portfolio value, max drawdown and turnover
+    std::vector<double> final_value;
+    std::vector<double> drawdown;
+    std::vector<double> turnover;
+
+    // Prints to the console the percentiles of all distributions
+    [[nodiscard]] auto output() const noexcept -> const std::stringstream;
+};
+
+#endif
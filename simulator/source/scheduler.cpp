@@ -0,0 +1,116 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "scheduler.h"
+
+#include <csignal>
+#include <pthread.h>
+
+// Set of signals requesting shutdown
+static auto shutdown_signals() noexcept -> sigset_t
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    return set;
+}
+
+Scheduler::Scheduler() noexcept
+{
+    sigset_t set(shutdown_signals());
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    signals = std::thread([this, set]() {
+        int received(0);
+        sigwait(&set, &received);
+        request_shutdown(received == SIGINT ? "Signal SIGINT received." : "Signal SIGTERM received.");
+    });
+
+    LOG.info("Scheduler constructor executed");
+}
+
+Scheduler::~Scheduler() noexcept
+{
+    // Signal thread is still waiting unless it received a signal - wake it with a signal of its own
+    request_shutdown("Program finished.");
+    pthread_kill(signals.native_handle(), SIGTERM);
+    signals.join();
+
+    LOG.info("Scheduler destructor executed");
+}
+
+auto Scheduler::wait_until(const std::chrono::steady_clock::time_point &deadline) noexcept -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_until(lock, deadline, [this]() { return shutdown; });
+    return !shutdown;
+}
+
+auto Scheduler::wait_for(const long &seconds) noexcept -> bool
+{
+    return wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(seconds));
+}
+
+void Scheduler::wait_shutdown() noexcept
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait(lock, [this]() { return shutdown; });
+}
+
+auto Scheduler::wait(const std::function<bool()> &ready, const bool &interruptible) noexcept -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait(lock, [this, &ready, &interruptible]() { return (interruptible && shutdown) || ready(); });
+    return !shutdown;
+}
+
+void Scheduler::notify() noexcept
+{
+    // Taking the lock orders the change of the condition before the check of a thread about to wait - no wakeup is lost
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    wakeup.notify_all();
+}
+
+void Scheduler::request_shutdown(const std::string &why) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (shutdown)
+        {
+            return;
+        }
+        shutdown = true;
+        reason = why;
+    }
+    wakeup.notify_all();
+}
+
+auto Scheduler::stopping() noexcept -> bool
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return shutdown;
+}
+
+auto Scheduler::get_reason() noexcept -> const std::string
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return reason;
+}
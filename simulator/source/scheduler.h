@@ -0,0 +1,68 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for timed waits of the program that end immediately on shutdown
+// SIGINT and SIGTERM are blocked in all threads and received by one dedicated thread that requests the shutdown
+// Construct before starting any other thread so that all threads inherit the blocked signals
+class Scheduler
+{
+public:
+    // Constructor - blocks SIGINT and SIGTERM and starts the signal thread
+    explicit Scheduler() noexcept;
+    // Destructor - stops the signal thread
+    ~Scheduler() noexcept;
+    // Dummies to comply with the Rule of Five
+    Scheduler(const Scheduler &source) = delete;
+    Scheduler(Scheduler &&source) = delete;
+    auto operator=(const Scheduler &source) -> Scheduler & = delete;
+    auto operator=(Scheduler &&source) -> Scheduler & = delete;
+
+    // Wait until "deadline" or for "seconds" - returns false if shutdown was requested before or while waiting
+    [[nodiscard]] auto wait_until(const std::chrono::steady_clock::time_point &deadline) noexcept -> bool;
+    [[nodiscard]] auto wait_for(const long &seconds) noexcept -> bool;
+    // Wait until shutdown was requested
+    void wait_shutdown() noexcept;
+    // Wait until "ready" returns true or, if "interruptible", shutdown was requested - returns false if shutdown was requested
+    // "ready" is checked under the lock of the scheduler and must not block - threads changing its outcome call notify()
+    [[nodiscard]] auto wait(const std::function<bool()> &ready, const bool &interruptible) noexcept -> bool;
+    // Wake all waiting threads to check their condition again
+    void notify() noexcept;
+
+    // Request shutdown - wakes all waiting threads, only the first reason is kept
+    void request_shutdown(const std::string &why) noexcept;
+    // Read out whether shutdown was requested and why
+    [[nodiscard]] auto stopping() noexcept -> bool;
+    [[nodiscard]] auto get_reason() noexcept -> const std::string;
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool shutdown{false};
+    std::string reason;
+
+    // Thread waiting for SIGINT and SIGTERM
+    std::thread signals;
+};
+
+#endif
@@ -0,0 +1,299 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sink.h"
+
+// Copy name into fixed size field - always leaves a terminating zero
+template <size_t N>
+static void copy_name(char (&field)[N], const std::string &name) noexcept
+{
+    size_t length(std::min(name.size(), N - 1));
+    std::copy(name.begin(), name.begin() + static_cast<long>(length), field);
+    std::fill(field + length, field + N, '\0');
+}
+
+// Append shortest representation of number that reads back exactly
+static void append_number(std::string &buffer, const double &number) noexcept
+{
+    char converted[32];
+    buffer.append(converted, std::to_chars(converted, converted + sizeof(converted), number).ptr);
+}
+
+// Append name as CSV field - quoted with doubled quotes if it contains a separator, quote or line break (RFC 4180)
+static void append_csv(std::string &buffer, std::string_view name) noexcept
+{
+    if (name.find_first_of(",\"\r\n") == std::string_view::npos)
+    {
+        buffer += name;
+        return;
+    }
+    buffer += '"';
+    for (auto const &character : name)
+    {
+        if (character == '"')
+        {
+            buffer += '"';
+        }
+        buffer += character;
+    }
+    buffer += '"';
+}
+
+// Append name as JSON string contents - quotes, backslashes and control characters are escaped
+static void append_json(std::string &buffer, std::string_view name) noexcept
+{
+    static constexpr char hex[]{"0123456789abcdef"};
+    for (auto const &character : name)
+    {
+        if (character == '"' || character == '\\')
+        {
+            buffer += '\\';
+            buffer += character;
+        }
+        else if (static_cast<unsigned char>(character) < 0x20)
+        {
+            buffer += "\\u00";
+            buffer += hex[static_cast<unsigned char>(character) >> 4];
+            buffer += hex[static_cast<unsigned char>(character) & 0xf];
+        }
+        else
+        {
+            buffer += character;
+        }
+    }
+}
+
+void Record::set_book(const std::string &name) noexcept
+{
+    copy_name(book, name);
+}
+
+void Record::set_asset(const std::string &name) noexcept
+{
+    copy_name(asset, name);
+}
+
+// Comma separated values with one header line per file
+class CsvSink final : public Sink
+{
+public:
+    [[nodiscard]] auto extension() const noexcept -> const std::string override { return "csv"; }
+
+    void header(std::string &buffer) const noexcept override
+    {
+        buffer += "kind,iteration,time,book,asset,value,weight,quantity,price,fee,performance,market,rebalance\n";
+    }
+
+    void encode(const Record &record, std::string &buffer) const noexcept override
+    {
+        buffer += record.kind;
+        buffer += ',' + std::to_string(record.iteration) + ',' + std::to_string(record.time) + ',';
+        append_csv(buffer, record.book);
+        buffer += ',';
+        append_csv(buffer, record.asset);
+        for (auto const &number : {record.value, record.weight, record.quantity, record.price, record.fee, record.performance, record.market, record.rebalance})
+        {
+            buffer += ',';
+            append_number(buffer, number);
+        }
+        buffer += '\n';
+    }
+};
+
+// One JSON object per line
+class JsonSink final : public Sink
+{
+public:
+    [[nodiscard]] auto extension() const noexcept -> const std::string override { return "jsonl"; }
+
+    void encode(const Record &record, std::string &buffer) const noexcept override
+    {
+        buffer += "{\"kind\":\"";
+        buffer += record.kind;
+        buffer += "\",\"iteration\":" + std::to_string(record.iteration) + ",\"time\":" + std::to_string(record.time);
+        buffer += ",\"book\":\"";
+        append_json(buffer, record.book);
+        buffer += "\",\"asset\":\"";
+        append_json(buffer, record.asset);
+        buffer += '"';
+        const std::pair<const char *, double> fields[]{{"value", record.value}, {"weight", record.weight},
+                                                       {"quantity", record.quantity}, {"price", record.price},
+                                                       {"fee", record.fee}, {"performance", record.performance},
+                                                       {"market", record.market}, {"rebalance", record.rebalance}};
+        for (auto const &field : fields)
+        {
+            buffer.append(",\"").append(field.first).append("\":");
+            // JSON knows no nan or inf
+            if (std::isfinite(field.second))
+            {
+                append_number(buffer, field.second);
+            }
+            else
+            {
+                buffer += "null";
+            }
+        }
+        buffer += "}\n";
+    }
+};
+
+// Records copied byte by byte - fixed size, host byte order
+class BinarySink final : public Sink
+{
+public:
+    [[nodiscard]] auto extension() const noexcept -> const std::string override { return "bin"; }
+
+    void encode(const Record &record, std::string &buffer) const noexcept override
+    {
+        static_assert(std::is_trivially_copyable<Record>::value && sizeof(Record) == 112, "Record must be plain data without padding");
+        buffer.append(reinterpret_cast<const char *>(&record), sizeof(Record));
+    }
+};
+
+auto make_sink(const std::string &format) noexcept -> std::unique_ptr<Sink>
+{
+    if (format == "csv")
+    {
+        return std::make_unique<CsvSink>();
+    }
+    if (format == "jsonl")
+    {
+        return std::make_unique<JsonSink>();
+    }
+    if (format == "binary")
+    {
+        return std::make_unique<BinarySink>();
+    }
+
+    LOG.warning("Unknown sink format", {{"format", format}});
+    return nullptr;
+}
+
+SinkWriter::SinkWriter(const std::string &formats, const std::string &path, const long &rotate) noexcept
+    : path(path), rotate(static_cast<size_t>(std::max(rotate, 1L))), queue(1 << 14)
+{
+    if (formats != CF.no_file)
+    {
+        for (auto const &format : str2vec(formats))
+        {
+            std::unique_ptr<Sink> sink(make_sink(format));
+            if (sink)
+            {
+                outputs.emplace_back();
+                outputs.back().sink = std::move(sink);
+            }
+        }
+    }
+
+    if (!outputs.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+        for (auto &output : outputs)
+        {
+            open_next(output);
+        }
+        writer = std::thread(&SinkWriter::run, this);
+    }
+
+    LOG.info("SinkWriter constructor executed", {{"sinks", outputs.size()}});
+}
+
+SinkWriter::~SinkWriter() noexcept
+{
+    running.store(false);
+    if (writer.joinable())
+    {
+        writer.join();
+    }
+
+    LOG.info("SinkWriter destructor executed", {{"dropped", dropped.load()}});
+}
+
+void SinkWriter::publish(const Record &record) noexcept
+{
+    if (!outputs.empty() && !queue.try_push(record))
+    {
+        dropped++;
+    }
+}
+
+void SinkWriter::run() noexcept
+{
+    Record record;
+    while (true)
+    {
+        // Stop flag is read before draining so no record queued before stopping is lost
+        bool stopping(!running.load());
+        size_t count(0);
+        while (queue.try_pop(record))
+        {
+            for (auto &output : outputs)
+            {
+                output.sink->encode(record, output.buffer);
+            }
+            count++;
+        }
+
+        for (auto &output : outputs)
+        {
+            if (!output.buffer.empty())
+            {
+                // Start a new file only once there is something to write into it
+                if (output.bytes > rotate)
+                {
+                    open_next(output);
+                }
+                output.file.write(output.buffer.data(), static_cast<long>(output.buffer.size()));
+                output.file.flush();
+                output.bytes += output.buffer.size();
+                output.buffer.clear();
+            }
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+        if (count == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+void SinkWriter::open_next(Output &output) noexcept
+{
+    output.file.close();
+
+    // Never overwrite files of earlier runs
+    std::string filename;
+    std::error_code error;
+    do
+    {
+        filename = path + "." + std::to_string(output.index++) + "." + output.sink->extension();
+    } while (std::filesystem::exists(filename, error));
+
+    std::string header;
+    output.sink->header(header);
+    output.file.open(filename, std::ios::binary);
+    output.file.write(header.data(), static_cast<long>(header.size()));
+    output.bytes = header.size();
+
+    LOG.info("SinkWriter opened file", {{"file", filename}});
+}
@@ -0,0 +1,125 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SINK_H
+#define SINK_H
+
+#include "config.h"
+#include "queue.h"
+#include "utils.h"
+
+// Struct for one machine-readable record of a polling iteration
+// Plain data of fixed size - the binary sink writes it as is in host byte order
+struct Record
+{
+    // Kind of record: 'S' state of one asset, 'T' trade of one asset, 'A' attribution of one asset, 'P' performance of one book
+    char kind{'S'};
+    char book[15]{};
+    char asset[16]{};
+    long iteration{0};
+    long time{0};
+    // State: value, weight, quantity and price of the asset after rebalancing
+    // Trade: change in value and quantity, price and fee of the rebalancing
+    // Attribution: running contribution of the asset in "value", its costs in "fee", split into "market" and "rebalance"
+    // Performance: value of the book in "value", performance since start in percent in "performance"
+    double value{0.0};
+    double weight{0.0};
+    double quantity{0.0};
+    double price{0.0};
+    double fee{0.0};
+    double performance{0.0};
+    double market{0.0};
+    double rebalance{0.0};
+
+    // Set name of book or asset - truncated to fit
+    void set_book(const std::string &name) noexcept;
+    void set_asset(const std::string &name) noexcept;
+};
+
+// Interface of one output format
+class Sink
+{
+public:
+    Sink() noexcept = default;
+    virtual ~Sink() noexcept = default;
+    // Dummies to comply with the Rule of Five
+    Sink(const Sink &source) = delete;
+    Sink(Sink &&source) = delete;
+    auto operator=(const Sink &source) -> Sink & = delete;
+    auto operator=(Sink &&source) -> Sink & = delete;
+
+    // File extension of the format
+    [[nodiscard]] virtual auto extension() const noexcept -> const std::string = 0;
+    // Append the header written at the start of every file to "buffer"
+    virtual void header(std::string & /*buffer*/) const noexcept {}
+    // Append one encoded record to "buffer"
+    virtual void encode(const Record &record, std::string &buffer) const noexcept = 0;
+};
+
+// Create a sink for "format" (csv, jsonl or binary) - returns nullptr for unknown formats
+[[nodiscard]] auto make_sink(const std::string &format) noexcept -> std::unique_ptr<Sink>;
+
+// Class for writing records to all configured sinks from a background thread
+// Every sink appends to its own files "path.index.extension", a new file is started once "rotate" bytes are exceeded
+class SinkWriter
+{
+public:
+    // Constructor - takes comma separated list of formats (or NONE), path without extension and size of files
+    explicit SinkWriter(const std::string &formats, const std::string &path, const long &rotate) noexcept;
+    // Destructor - writes out all queued records and stops writer thread
+    ~SinkWriter() noexcept;
+    // Dummies to comply with the Rule of Five
+    SinkWriter(const SinkWriter &source) = delete;
+    SinkWriter(SinkWriter &&source) = delete;
+    auto operator=(const SinkWriter &source) -> SinkWriter & = delete;
+    auto operator=(SinkWriter &&source) -> SinkWriter & = delete;
+
+    // Queue record for writing - never blocks, drops the record if the queue is full (call from one thread only)
+    void publish(const Record &record) noexcept;
+
+    // Read out whether any sink is configured and number of dropped records
+    [[nodiscard]] auto enabled() const noexcept -> bool { return !outputs.empty(); }
+    [[nodiscard]] auto number_dropped() const noexcept -> size_t { return dropped.load(); }
+
+private:
+    // One sink with its current file
+    struct Output
+    {
+        std::unique_ptr<Sink> sink;
+        std::ofstream file;
+        std::string buffer;
+        size_t bytes{0};
+        size_t index{0};
+    };
+
+    std::string path;
+    size_t rotate;
+    std::vector<Output> outputs;
+
+    SpscQueue<Record> queue;
+    std::atomic<bool> running{true};
+    std::atomic<size_t> dropped{0};
+    std::thread writer;
+
+    // Loop of writer thread - encodes and writes queued records until stopped and queue is empty
+    void run() noexcept;
+    // Close current file of output and open the next unused one
+    void open_next(Output &output) noexcept;
+};
+
+#endif
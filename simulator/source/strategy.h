@@ -0,0 +1,81 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "config.h"
+#include "utils.h"
+
+// Base for all strategies predicting portfolio weights (CRTP - resolved at compile time)
+// A strategy "Derived" implements:
+//     void calculate_weights(double **returns, const size_t &ti, std::vector<double> &weights) noexcept;
+// It receives the returns of all assets up to and including timebin ti and fills one weight per asset
+// The weights vector is sized by the caller - strategies must not allocate while calculating weights
+template <typename Derived>
+class Strategy
+{
+public:
+    // Predict portfolio weights - statically dispatched into the derived strategy
+    void predict_weights(double **returns, const size_t &ti, std::vector<double> &weights) noexcept
+    {
+        static_cast<Derived *>(this)->calculate_weights(returns, ti, weights);
+    }
+
+    // Forget all state carried over from earlier timebins - stateless strategies have nothing to forget
+    // Strategies with state hide this with their own reset(), calls are resolved on the concrete type
+    void reset() noexcept {}
+
+    // Train on timebins [begin, end) before trading - by default warms up the strategy state by predicting each timebin
+    void train(double **returns, const size_t &begin, const size_t &end, std::vector<double> &weights) noexcept
+    {
+        for (size_t ti(begin); ti < end; ti++)
+        {
+            predict_weights(returns, ti, weights);
+        }
+    }
+};
+
+// Strategy selling all crypto assets into the riskfree asset
+class Deinvest : public Strategy<Deinvest>
+{
+public:
+    explicit Deinvest(const size_t & /*assets*/) noexcept {}
+
+    void calculate_weights(double ** /*returns*/, const size_t & /*ti*/, std::vector<double> &weights) noexcept
+    {
+        std::fill(weights.begin(), weights.end(), 0.0);
+    }
+};
+
+// Strategy balancing all assets including the riskfree asset to equal portfolio weight
+class EqualWeight : public Strategy<EqualWeight>
+{
+public:
+    explicit EqualWeight(const size_t &assets) noexcept : weight(1.0 / static_cast<double>(assets)) {}
+
+    void calculate_weights(double ** /*returns*/, const size_t & /*ti*/, std::vector<double> &weights) noexcept
+    {
+        std::fill(weights.begin(), weights.end(), weight);
+    }
+
+private:
+    double weight;
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tick.h"
+
+TickReplay::TickReplay(const std::string &filename, const std::vector<std::string> &names) noexcept
+{
+    std::map<std::string, size_t> index;
+    for (size_t asset(1); asset < names.size(); asset++)
+    {
+        index[names[asset]] = asset;
+    }
+
+    std::string line, ticker;
+    std::ifstream stream(filename);
+
+    if (stream.is_open())
+    {
+        while (std::getline(stream, line))
+        {
+            std::istringstream linestream(line);
+            Tick tick;
+            if (linestream >> tick.time >> ticker >> tick.ask >> tick.bid >> tick.price && index.count(ticker) > 0)
+            {
+                tick.asset = index[ticker];
+                ticks.emplace_back(tick);
+            }
+        }
+    }
+    stream.close();
+
+    // Recordings of several runs may be appended to one file - keep order of equal times
+    std::stable_sort(ticks.begin(), ticks.end(), [](const auto &left, const auto &right) { return left.time < right.time; });
+
+    LOG.info("TickReplay constructor executed", {{"ticks", ticks.size()}, {"file", filename}});
+}
+
+auto TickResult::output() const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Tick-level backtest over " << std::to_string(snapshots) << " snapshots and " << std::to_string(events) << " events" << std::endl;
+    result << "..................................................................................................................." << std::endl;
+    result << "Performance at bid:   " << num2str(value_start > 0.0 ? 100.0 * (value_end / value_start - 1.0) : 0.0) << " %" << std::endl;
+    result << "Max drawdown at bid:  " << num2str(100.0 * drawdown) << " %" << std::endl;
+    result << "Rebalancings:         " << std::setw(10) << trades << std::endl;
+    result << "Turnover:             " << num2str(turnover) << std::endl;
+    result << "Fees:                 " << num2str(fees) << std::endl;
+    result << "Events per second:    " << num2str(seconds > 0.0 ? static_cast<double>(events) / seconds : 0.0) << std::endl;
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
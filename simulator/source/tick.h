@@ -0,0 +1,69 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TICK_H
+#define TICK_H
+
+#include "config.h"
+#include "utils.h"
+
+// Struct for one recorded ticker snapshot of one asset
+struct Tick
+{
+    long time{0};
+    size_t asset{0};
+    double ask{0.0};
+    double bid{0.0};
+    double price{0.0};
+};
+
+// Class for loading recorded ticker snapshots of the assets of one portfolio in timestamp order
+// Snapshots are recorded by MarketData::poll() as lines "time ticker ask bid last" into TICK_FILE
+class TickReplay
+{
+public:
+    // Constructor - takes file of recorded snapshots and names of portfolio assets (riskfree first)
+    // Tickers not held by the portfolio are skipped
+    explicit TickReplay(const std::string &filename, const std::vector<std::string> &names) noexcept;
+
+    // Read out number of loaded ticks
+    [[nodiscard]] auto size() const noexcept -> size_t { return ticks.size(); }
+
+    // Ticks sorted by time - ticks of equal time form one snapshot of the market
+    std::vector<Tick> ticks;
+};
+
+// Struct for storing the result of one tick-level backtest
+struct TickResult
+{
+    size_t events{0};
+    size_t snapshots{0};
+    size_t trades{0};
+    // Portfolio value at bid prices before first and after last snapshot
+    double value_start{0.0};
+    double value_end{0.0};
+    double drawdown{0.0};
+    double turnover{0.0};
+    double fees{0.0};
+    double seconds{0.0};
+
+    // Prints to the console the metrics of the tick-level backtest
+    [[nodiscard]] auto output() const noexcept -> const std::stringstream;
+};
+
+#endif
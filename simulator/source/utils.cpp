@@ -21,16 +21,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 void get_system_time(long &data) noexcept
 {
     time_t result(std::time(nullptr));
-    std::asctime(std::localtime(&result));
-
     data = static_cast<long>(result);
 }
 
 auto time2str(const long &unixtime) noexcept -> const std::string
 {
+    // Reentrant conversion - books of one iteration format their times concurrently
     time_t ut(unixtime);
+    struct tm local;
+    localtime_r(&ut, &local);
     char converted[100];
-    std::strftime(converted, sizeof(converted), "%F - %T", std::localtime(&ut));
+    std::strftime(converted, sizeof(converted), "%F - %T", &local);
 
     return std::string(converted);
 }
@@ -50,12 +51,53 @@ auto get_unix_time(const int &years, const int &months, const int &days, const i
 
 auto num2str(const double &number) noexcept -> const std::string
 {
-    std::ostringstream stream;
-    stream << std::fixed;
-    stream << std::setprecision(4);
-    stream << std::setw(10);
-    stream << std::setfill(' ');
-    stream << number;
-
-    return stream.str();
+    char converted[320];
+    return std::string(converted, num2chars(converted, converted + sizeof(converted), number));
+}
+
+auto num2chars(char *first, char *last, const double &number) noexcept -> char *
+{
+    static constexpr long width{10};
+
+    // Correctly rounded to four decimals - same digits as printf("%.4f")
+    auto [end, error] = std::to_chars(first, last, number, std::chars_format::fixed, 4);
+    if (error != std::errc())
+    {
+        return first;
+    }
+
+    // Right-align in a field of fixed width - same as std::setw
+    if (end - first < width)
+    {
+        std::copy_backward(first, end, first + width);
+        std::fill(first, first + width - (end - first), ' ');
+        end = first + width;
+    }
+
+    return end;
+}
+
+auto str2vec(const std::string &input) noexcept -> const std::vector<std::string>
+{
+    std::vector<std::string> result;
+    std::stringstream stream(input);
+    while (stream.good())
+    {
+        std::string substring;
+        std::getline(stream, substring, ',');
+        result.emplace_back(substring);
+    }
+
+    return result;
+}
+
+auto vec2str(const std::vector<std::string> &input) noexcept -> const std::string
+{
+    std::string result;
+    for (auto const &element : input)
+    {
+        result += (result.empty() ? "" : ",") + element;
+    }
+
+    return result;
 }
@@ -20,16 +20,31 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define UTILS_H
 
 // Includes from C++ STL in one location
+#include <cctype>
+#include <charconv>
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
+#include <variant>
 #include <vector>
 #include <atomic>
 #include <algorithm>
@@ -45,5 +60,12 @@ auto get_unix_time(const int &year, const int &month, const int &day, const int
 
 // Format strings for output in console
 auto num2str(const double &number) noexcept -> const std::string;
+// Format number as num2str into characters from "first" on without allocating - returns end of characters written
+// Range up to "last" must hold at least 10 characters, and 320 characters for any double
+auto num2chars(char *first, char *last, const double &number) noexcept -> char *;
+
+// Split a comma separated list into its elements and join elements into a comma separated list
+auto str2vec(const std::string &input) noexcept -> const std::vector<std::string>;
+auto vec2str(const std::vector<std::string> &input) noexcept -> const std::string;
 
 #endif
@@ -0,0 +1,85 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "walkforward.h"
+
+WalkForward::WalkForward(const size_t &train, const size_t &test, const size_t &timebins) noexcept
+{
+    // First test period starts after one full training period, following ones roll forward by one test period
+    for (size_t begin(std::max(train, static_cast<size_t>(1))); test > 0 && begin < timebins; begin += test)
+    {
+        Window window;
+        window.train_begin = begin - std::min(train, begin);
+        window.test_begin = begin;
+        window.test_end = std::min(begin + test, timebins);
+        windows.emplace_back(window);
+    }
+}
+
+void WalkForward::stitch() noexcept
+{
+    equity.clear();
+    double level(1.0);
+    for (auto const &window : windows)
+    {
+        for (auto const &relative : window.equity)
+        {
+            equity.emplace_back(level * relative);
+        }
+        if (!window.equity.empty())
+        {
+            level *= window.equity.back();
+        }
+    }
+}
+
+auto WalkForward::output() const noexcept -> const std::stringstream
+{
+    std::stringstream result;
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Walk-forward backtest with " << std::to_string(windows.size()) << " windows" << std::endl;
+    result << "..................................................................................................................." << std::endl;
+    for (auto const &window : windows)
+    {
+        result << "Train: " << std::setw(6) << window.train_begin << " to " << std::setw(6) << window.test_begin - 1;
+        result << "   Test: " << std::setw(6) << window.test_begin << " to " << std::setw(6) << window.test_end - 1;
+        result << "   Perf.: " << num2str(100.0 * window.performance) << " %";
+        result << "   Vola.: " << num2str(100.0 * window.volatility) << " %";
+        result << "   Drawdown: " << num2str(100.0 * window.drawdown) << " %";
+        result << "   Turnover: " << num2str(window.turnover);
+        result << "   Fees: " << num2str(window.fees);
+        result << std::endl;
+    }
+
+    // Maximum drawdown of the stitched equity curve
+    double peak(1.0), drawdown(0.0);
+    for (auto const &level : equity)
+    {
+        peak = std::max(peak, level);
+        drawdown = std::max(drawdown, 1.0 - level / peak);
+    }
+
+    result << "..................................................................................................................." << std::endl;
+    result << "Out-of-sample timebins:     " << std::to_string(equity.size()) << std::endl;
+    result << "Out-of-sample performance:  " << num2str(equity.empty() ? 0.0 : 100.0 * (equity.back() - 1.0)) << " %" << std::endl;
+    result << "Out-of-sample max drawdown: " << num2str(100.0 * drawdown) << " %" << std::endl;
+    result << "..................................................................................................................." << std::endl;
+
+    return result;
+}
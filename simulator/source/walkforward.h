@@ -0,0 +1,61 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WALKFORWARD_H
+#define WALKFORWARD_H
+
+#include "config.h"
+#include "utils.h"
+
+// Struct for storing one (train, test) window of a walk-forward backtest and its out-of-sample metrics
+struct Window
+{
+    // Timebins of training [train_begin, test_begin) and of testing [test_begin, test_end)
+    size_t train_begin{0};
+    size_t test_begin{0};
+    size_t test_end{0};
+    // Portfolio value relative to start of test for every test timebin
+    std::vector<double> equity;
+    // Out-of-sample metrics of the test period
+    double performance{0.0};
+    double volatility{0.0};
+    double drawdown{0.0};
+    double turnover{0.0};
+    double fees{0.0};
+};
+
+// Class for splitting the historic data into rolling windows and collecting the results
+class WalkForward
+{
+public:
+    // Constructor - takes length of training and testing period in timebins and total number of timebins
+    explicit WalkForward(const size_t &train, const size_t &test, const size_t &timebins) noexcept;
+
+    // Chain the equity of all test periods into one out-of-sample equity curve
+    void stitch() noexcept;
+
+    // Prints to the console the metrics of all windows and of the stitched equity curve
+    [[nodiscard]] auto output() const noexcept -> const std::stringstream;
+
+    // Windows in chronological order - test periods do not overlap
+    std::vector<Window> windows;
+    // Stitched out-of-sample equity curve - one value per tested timebin, starting from 1.0
+    std::vector<double> equity;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "watcher.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+Watcher::Watcher(const std::string &file) noexcept
+    : name(std::filesystem::path(file).filename().string())
+{
+    std::string directory(std::filesystem::path(file).parent_path().string());
+    notify = inotify_init1(IN_CLOEXEC);
+    wakeup = eventfd(0, EFD_CLOEXEC);
+    if (notify < 0 || wakeup < 0 || inotify_add_watch(notify, directory.empty() ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        LOG.warning("Watcher cannot watch configuration file - changes need a restart", {{"file", file}});
+        return;
+    }
+
+    watcher = std::thread(&Watcher::run, this);
+
+    LOG.info("Watcher constructor executed", {{"file", file}});
+}
+
+Watcher::~Watcher() noexcept
+{
+    if (watcher.joinable())
+    {
+        uint64_t stop(1);
+        if (write(wakeup, &stop, sizeof(stop)) == sizeof(stop))
+        {
+            watcher.join();
+        }
+        else
+        {
+            watcher.detach();
+        }
+    }
+    for (int descriptor : {notify, wakeup})
+    {
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+    }
+
+    LOG.info("Watcher destructor executed", {{"reloads", reloads}});
+}
+
+void Watcher::run() noexcept
+{
+    // Buffer aligned for the inotify events it receives
+    alignas(inotify_event) char buffer[4096];
+    pollfd descriptors[2]{{notify, POLLIN, 0}, {wakeup, POLLIN, 0}};
+    while (poll(descriptors, 2, -1) >= 0 && (descriptors[1].revents & POLLIN) == 0)
+    {
+        if ((descriptors[0].revents & POLLIN) == 0)
+        {
+            continue;
+        }
+        ssize_t length(read(notify, buffer, sizeof(buffer)));
+        bool changed(false);
+        for (ssize_t offset(0); offset < length;)
+        {
+            auto event(reinterpret_cast<const inotify_event *>(buffer + offset));
+            changed = changed || (event->len > 0 && name == event->name);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+
+        // Snapshot is swapped only if all changeable parameters of the new file are valid
+        if (changed && CF.reload())
+        {
+            reloads++;
+        }
+    }
+}
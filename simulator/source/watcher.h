@@ -0,0 +1,52 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include "config.h"
+#include "utils.h"
+
+// Class for watching the configuration file and reloading the configuration whenever the file was written
+// Watches the directory of the file, so that editors replacing the file instead of writing it are noticed as well
+class Watcher
+{
+public:
+    // Constructor - starts watching "file" on a thread of its own
+    explicit Watcher(const std::string &file) noexcept;
+    // Destructor - stops watching
+    ~Watcher() noexcept;
+    // Dummies to comply with Rule of Five
+    Watcher(const Watcher &source) = delete;
+    Watcher(Watcher &&source) = delete;
+    auto operator=(const Watcher &source) -> Watcher & = delete;
+    auto operator=(Watcher &&source) -> Watcher & = delete;
+
+private:
+    // Descriptors of the inotify instance and of the event waking the thread on destruction
+    int notify{-1};
+    int wakeup{-1};
+    std::string name;
+    long reloads{0};
+    std::thread watcher;
+
+    // Wait for changes of the file and reload the configuration on each of them
+    void run() noexcept;
+};
+
+#endif
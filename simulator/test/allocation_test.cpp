@@ -0,0 +1,91 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../source/allocation.h"
+#include "../source/predict.h"
+
+// Build a portfolio of the riskfree asset and "assets" crypto assets over "timebins" bars of a synthetic random walk
+static auto make_portfolio(const size_t &assets, const size_t &timebins) noexcept -> std::shared_ptr<Portfolio>
+{
+    std::mt19937_64 generator(42);
+    std::normal_distribution<double> step(0.0, 0.03);
+
+    std::vector<long> times(timebins);
+    for (size_t ti(0); ti < timebins; ti++)
+    {
+        times[ti] = 1600000000L + static_cast<long>(ti) * 86400L;
+    }
+
+    auto riskfree(std::make_unique<Asset>(CF.riskfree_name));
+    riskfree->fill_historic_riskfree(times);
+    riskfree->set_historic_quantity(1000.0, 0);
+    auto portfolio(std::make_shared<Portfolio>(std::move(riskfree)));
+
+    for (size_t asset(0); asset < assets; asset++)
+    {
+        auto crypto(std::make_unique<Asset>("ASSET" + std::to_string(asset)));
+        double price(10.0 * static_cast<double>(asset + 1));
+        for (size_t ti(0); ti < timebins; ti++)
+        {
+            price *= std::exp(step(generator));
+            crypto->historic.time.emplace_back(times[ti]);
+            crypto->historic.open.emplace_back(price);
+            crypto->historic.high.emplace_back(price);
+            crypto->historic.low.emplace_back(price);
+            crypto->historic.close.emplace_back(price);
+            crypto->historic.vwap.emplace_back(price);
+            crypto->historic.volume.emplace_back(1.0);
+            crypto->historic.count.emplace_back(1);
+            crypto->historic.quantity.emplace_back(0.0);
+        }
+        crypto->set_historic_quantity(static_cast<double>(assets - asset), 0);
+        portfolio->add_asset(std::move(crypto));
+    }
+    return portfolio;
+}
+
+// Run the historic optimization of every strategy on a synthetic portfolio - fails if its loop touches the heap
+auto main() -> int
+{
+    if (!allocations_counted)
+    {
+        std::cout << "allocation test needs ACCPO_COUNT_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+
+    CF.interval = "1440";
+    CF.trade_fee = 0.0026;
+    CF.hrp_lookback = 90;
+    CF.hrp_tolerance = 0.05;
+
+    size_t failures(0);
+    for (const char *strategy : {"deinvest", "equal", "hrp"})
+    {
+        auto optimizer(make_optimizer(strategy, make_portfolio(8, 1000)));
+
+        // Entries of the set-up are written out first - the logger thread must not allocate during the measurement
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        optimizer->history_calculate();
+
+        size_t allocations(optimizer->get_history_allocations());
+        std::cout << "history_calculate() of " << strategy << " allocated " << allocations << " times" << std::endl;
+        failures += allocations == 0 ? 0 : 1;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
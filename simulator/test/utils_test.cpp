@@ -0,0 +1,72 @@
+/*
+ACCPO - Autonomous CryptoCurrency Portfolio Optimization
+Copyright (C) - 2020 - Dr. Alexander M. Beck - dralmabeck@gmail.com
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../source/utils.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Compare num2chars against printf("%10.4f") - returns number of mismatches
+static auto compare(const double &number) noexcept -> size_t
+{
+    char expected[400];
+    char actual[400];
+    std::snprintf(expected, sizeof(expected), "%10.4f", number);
+    char *end(num2chars(actual, actual + sizeof(actual), number));
+    *end = '\0';
+
+    if (std::strcmp(expected, actual) != 0)
+    {
+        std::cout << "num2chars mismatch for " << std::hexfloat << number << std::defaultfloat << ": expected \"" << expected << "\" got \"" << actual << "\"" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+auto main() -> int
+{
+    size_t mismatches(0);
+
+    // Values where rounding the product of the fraction goes wrong
+    for (const double &number : {0.0, -0.0, 0.12345, 5.0e-05, -5.0e-05, 0.00005, 1.00005, 2.5e-05, 0.99995, 9999.99995, 1.0e14, -1.0e14, 1.0e300, -123456.78915})
+    {
+        mismatches += compare(number);
+    }
+
+    // Values at and next to decimal ties of the fourth digit
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<long> digits(-100000000, 100000000);
+    for (size_t ii(0); ii < 1000000; ii++)
+    {
+        double tie((static_cast<double>(digits(generator)) + 0.5) / 10000.0);
+        mismatches += compare(tie);
+        mismatches += compare(std::nextafter(tie, 0.0));
+        mismatches += compare(std::nextafter(tie, 1.0e15));
+    }
+
+    // Values spread over many magnitudes
+    std::uniform_real_distribution<double> exponent(-10.0, 20.0);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    for (size_t ii(0); ii < 1000000; ii++)
+    {
+        mismatches += compare(mantissa(generator) * std::pow(10.0, exponent(generator)));
+    }
+
+    std::cout << "num2chars test finished with " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}